@@ -44,7 +44,7 @@ llvm::Value *getOrInsertFunction(llvm::Module *module, StringRef name, FunctionT
   return module->getOrInsertFunction(name, type).getCallee();
 }
 
-void writeBitcodeToFile(const llvm::Module &module, llvm::raw_fd_ostream &stream) {
+void writeBitcodeToFile(const llvm::Module &module, llvm::raw_ostream &stream) {
   llvm::WriteBitcodeToFile(module, stream);
 }
 
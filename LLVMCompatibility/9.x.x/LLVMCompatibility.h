@@ -11,7 +11,7 @@ class FunctionType;
 class Value;
 class Module;
 class raw_pwrite_stream;
-class raw_fd_ostream;
+class raw_ostream;
 
 namespace object {
 class SectionRef;
@@ -29,7 +29,7 @@ llvm::DICompileUnit *getUnit(const llvm::DebugLoc &debugLocation);
 std::string demangle(const std::string &MangledName);
 llvm::Value *getOrInsertFunction(llvm::Module *module, llvm::StringRef name,
                                  llvm::FunctionType *type);
-void writeBitcodeToFile(const llvm::Module &module, llvm::raw_fd_ostream &stream);
+void writeBitcodeToFile(const llvm::Module &module, llvm::raw_ostream &stream);
 bool addPassesToEmitObjectFile(llvm::TargetMachine *targetMachine,
                                llvm::legacy::PassManagerBase &passManager,
                                llvm::raw_pwrite_stream &out);
@@ -28,6 +28,7 @@ public:
   void addMutation(MutationPoint *point);
 
   std::map<llvm::Function *, std::vector<MutationPoint *>> &getMutationPointsMap();
+  const std::map<llvm::Function *, std::vector<MutationPoint *>> &getMutationPointsMap() const;
 
 private:
   std::unique_ptr<llvm::LLVMContext> context;
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mull {
+
+class Diagnostics;
+
+/// Finds the bitcode embedded into an executable with -fembed-bitcode (the .llvmbc section on
+/// ELF, __LLVM,__bitcode on Mach-O). The linker concatenates the sections of all the object
+/// files, so a section holds one bitcode file per translation unit.
+///
+/// The executable is memory mapped and the buffers point straight into it: they are valid as
+/// long as the extractor is alive.
+class BitcodeExtractor {
+public:
+  explicit BitcodeExtractor(Diagnostics &diagnostics);
+
+  std::vector<llvm::MemoryBufferRef> extractBitcode(const std::string &executable);
+
+private:
+  Diagnostics &diagnostics;
+  std::unique_ptr<llvm::MemoryBuffer> executableBuffer;
+};
+
+} // namespace mull
@@ -20,6 +20,11 @@ std::unique_ptr<llvm::Module> loadModuleFromBuffer(llvm::LLVMContext &context,
                                                    Diagnostics &diagnostics);
 std::unique_ptr<llvm::Module> parseBitcode(llvm::MemoryBufferRef bufferRef,
                                            llvm::LLVMContext &context, Diagnostics &diagnostics);
+/// Only the module-level information is parsed, the function bodies are materialized on demand.
+/// The module takes ownership of the buffer
+std::unique_ptr<llvm::Module> loadLazyModuleFromBuffer(llvm::LLVMContext &context,
+                                                       std::unique_ptr<llvm::MemoryBuffer> buffer,
+                                                       Diagnostics &diagnostics);
 
 class BitcodeLoader {
   std::vector<std::unique_ptr<llvm::LLVMContext>> contexts;
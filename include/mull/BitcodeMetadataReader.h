@@ -2,15 +2,25 @@
 
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
+namespace llvm {
+class MemoryBufferRef;
+}
+
 namespace mull {
 class Bitcode;
+class Diagnostics;
 
 class BitcodeMetadataReader {
 public:
   std::map<std::string, std::string>
   getCompilationDatabase(std::vector<std::unique_ptr<mull::Bitcode>> &bitcode);
+  /// Loads the modules lazily one at a time, the function bodies are never materialized
+  std::map<std::string, std::string>
+  getCompilationDatabase(const std::vector<llvm::MemoryBufferRef> &bitcodeBuffers,
+                         Diagnostics &diagnostics);
 };
 
 } // namespace mull
@@ -20,17 +20,42 @@ struct Configuration {
   bool keepObjectFiles;
   bool keepExecutable;
   bool mutateOnly;
+  bool forkServer;
+  bool mutantSchemata;
+  bool inProcessLinker;
+  /// The baseline run finds the covered mutants that the tests never execute
+  bool reachabilityProbes;
+  /// Mutants that optimize to the original code are dropped, duplicates share one execution
+  bool detectEquivalentMutants;
 
   int timeout;
   unsigned linkerTimeout;
+  /// Megabytes, zero loads all the modules at once
+  unsigned memoryBudget;
+  /// The mutants are split into shardCount shards, only shardIndex is run.
+  /// Zero or one runs all the mutants
+  unsigned shardIndex;
+  unsigned shardCount;
 
   IDEDiagnosticsKind diagnostics;
+  CodegenProfile codegenProfile;
+  TestFrameworkKind testFramework;
 
   std::vector<std::string> bitcodePaths;
 
   std::string executable;
   std::string outputFile;
   std::string coverageInfo;
+  std::string cacheDirectory;
+  /// Where the kill history of the tests is kept, empty disables test prioritization
+  std::string testHistory;
+  /// Where the per-test kill matrix is kept, empty disables mutant subsumption
+  std::string killMatrix;
+  /// Where the mutant results are kept between runs, empty disables the cache
+  std::string resultCache;
+
+  /// Shell commands that start the workers executing the mutants, empty runs them locally
+  std::vector<std::string> workerCommands;
 
   std::string linker;
   std::vector<std::string> linkerFlags;
@@ -7,6 +7,19 @@ namespace mull {
 
 enum class IDEDiagnosticsKind { None, Survived, Killed, All };
 
+/// FastCompile: no optimizations, FastISel, no debug info.
+/// FastRun: host CPU features, aggressive codegen, and O2 function passes on mutated functions.
+/// Auto: picks one of the above based on the estimated compilation and execution times.
+enum class CodegenProfile { Default, FastCompile, FastRun, Auto };
+std::string codegenProfileName(CodegenProfile profile);
+/// Returns false if there is no profile with the name
+bool parseCodegenProfile(const std::string &name, CodegenProfile &profile);
+
+/// None runs the whole test program for each mutant.
+/// Otherwise the test cases are run one by one to find out which of them reach each mutant,
+/// and a mutant then runs only against the tests that reach it.
+enum class TestFrameworkKind { None, GoogleTest, Catch2, Doctest };
+
 struct ParallelizationConfig {
   int workers;
   int testExecutionWorkers;
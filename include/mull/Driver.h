@@ -6,14 +6,24 @@
 #include "mull/MutationResult.h"
 #include "mull/Mutators/Mutator.h"
 #include "mull/Parallelization/TaskExecutor.h"
+#include "mull/Runtime/ReachabilityRuntime.h"
+#include "mull/Sharding.h"
 #include "mull/Toolchain/Toolchain.h"
 
+#include <functional>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace llvm {
 
 class Module;
 class Function;
+class MemoryBufferRef;
+
+namespace coverage {
+class CoverageMapping;
+}
 
 } // namespace llvm
 
@@ -29,6 +39,8 @@ class JunkDetector;
 class FunctionFilter;
 struct Filters;
 class Diagnostics;
+class ResultCache;
+class MutantRunner;
 
 class Driver {
   const Configuration &config;
@@ -40,6 +52,25 @@ class Driver {
 
   struct Filters &filters;
   SingleTaskExecutor singleTask;
+  /// Shared by all the phases of the pipeline
+  ThreadPool threadPool;
+  /// Zero if the sanity check run was skipped
+  long long originalRunningTime;
+  std::unique_ptr<llvm::coverage::CoverageMapping> coverage;
+  bool coverageLoaded;
+  std::unique_ptr<ResultCache> resultCache;
+  /// Grows with every batch, the slots of the previous batches are never reused
+  ReachabilitySlots reachabilitySlots;
+  /// A mutant is equivalent if all of its covered points are, so both sets are kept
+  std::unordered_set<std::string> equivalentMutants;
+  std::unordered_set<std::string> nonEquivalentMutants;
+  /// The fingerprints of the mutated functions of each mutant
+  std::unordered_map<std::string, std::vector<std::string>> mutantFingerprints;
+  /// Maps a duplicate mutant to the mutant with the same code, the duplicate shares its result
+  std::unordered_map<std::string, std::string> duplicateMutants;
+  MutantSet shardedMutants;
+  /// The instructions of the original functions each mutant changes, the shards are balanced by it
+  std::unordered_map<std::string, long long> mutantCosts;
 
 public:
   Driver(Diagnostics &diagnostics, const Configuration &config, Program &program, Toolchain &t,
@@ -48,24 +79,60 @@ public:
   ~Driver();
 
   std::unique_ptr<Result> run();
+  /// All the mutants the shard was selected from
+  const MutantSet &getShardedMutants() const;
 
 private:
+  /// Loads, mutates and compiles the modules in batches that fit into the memory budget
+  std::unique_ptr<Result> streamingRun();
+  void loadBitcode(std::vector<llvm::MemoryBufferRef> &bitcodeBuffers);
+
+  void runSanityCheck();
   std::vector<MutationPoint *> findMutationPoints();
   std::vector<MutationPoint *> filterMutations(std::vector<MutationPoint *> mutationPoints);
   std::vector<FunctionUnderTest> filterFunctions(std::vector<FunctionUnderTest> functions);
+  /// Parses the bodies of the functions under test, the rest is parsed right before compilation
+  void materializeFunctions(const std::vector<FunctionUnderTest> &functions);
   void selectInstructions(std::vector<FunctionUnderTest> &functions);
 
+  void materializeAllFunctions();
+  /// Must run before the mutations are applied, the cache keys are based on the original code
+  void hashProgram(const std::vector<MutationPoint *> &mutationPoints);
   void prepareMutations(std::vector<MutationPoint *> mutationPoints);
+  /// Must run after equivalent mutant detection, the probes change the original functions
+  void insertReachabilityProbes();
+  void detectEquivalentMutants(const std::vector<MutationPoint *> &mutationPoints);
+  /// Drops the equivalent mutants and finds the duplicates
+  void dropEquivalentMutants(std::vector<std::unique_ptr<Mutant>> &mutants);
+  void prepareForkServer();
+  /// Must run before the mutations are applied, the estimates are based on the original code
+  void estimateMutantCosts(const std::vector<MutationPoint *> &mutationPoints);
+  /// Drops the mutants that belong to other shards, balancing the shards by the estimated costs
+  void keepShard(std::vector<std::unique_ptr<Mutant>> &mutants);
 
   std::vector<std::unique_ptr<MutationResult>>
   runMutations(std::vector<std::unique_ptr<Mutant>> &mutants);
+  /// Runs only the mutants that have no valid cached result
+  std::vector<std::unique_ptr<MutationResult>>
+  reuseCachedResults(std::vector<std::unique_ptr<Mutant>> &mutants,
+                     const std::function<std::vector<std::unique_ptr<MutationResult>>(
+                         std::vector<std::unique_ptr<Mutant>> &)> &runMutants);
 
   std::vector<std::unique_ptr<MutationResult>>
   dryRunMutations(std::vector<std::unique_ptr<Mutant>> &mutants);
   std::vector<std::unique_ptr<MutationResult>>
   normalRunMutations(std::vector<std::unique_ptr<Mutant>> &mutants);
+  std::vector<std::string> compileProgram(size_t mutantsCount);
+  /// Runs one mutant of each group of duplicates, the others share its result
+  std::vector<std::unique_ptr<MutationResult>>
+  runDistinctMutants(MutantRunner &mutantRunner, const std::string &executable,
+                     std::vector<std::unique_ptr<Mutant>> &mutants);
+  std::vector<std::unique_ptr<MutationResult>>
+  linkAndRunMutants(std::vector<std::string> &objectFiles,
+                    std::vector<std::unique_ptr<Mutant>> &mutants);
 
   std::vector<FunctionUnderTest> getFunctionsUnderTest();
+  CodegenProfile selectCodegenProfile(size_t mutantsCount);
 };
 
 } // namespace mull
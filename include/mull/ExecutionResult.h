@@ -40,14 +40,32 @@ static std::string executionStatusAsString(ExecutionStatus status) {
   }
 }
 
+/// Executed: the mutant ran in this session. Cached: the status is reused from an earlier run.
+/// Inferred: the status is taken from a mutant that subsumes this one
+enum class StatusSource { Executed = 0, Cached = 1, Inferred = 2 };
+
+static std::string statusSourceAsString(StatusSource source) {
+  switch (source) {
+  case StatusSource::Executed:
+    return "Executed";
+  case StatusSource::Cached:
+    return "Cached";
+  case StatusSource::Inferred:
+    return "Inferred";
+  }
+  return "Unknown";
+}
+
 struct ExecutionResult {
   ExecutionStatus status;
+  StatusSource source;
   int exitStatus;
   long long runningTime;
   std::string stdoutOutput;
   std::string stderrOutput;
   ExecutionResult()
-      : status(ExecutionStatus::Invalid), exitStatus(0), runningTime(0) {}
+      : status(ExecutionStatus::Invalid), source(StatusSource::Executed), exitStatus(0),
+        runningTime(0) {}
 
   std::string getStatusAsString() {
     return executionStatusAsString(this->status);
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "mull/Filters/MutationFilter.h"
+#include "mull/Mutators/MutatorKind.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class Instruction;
+}
+
+namespace mull {
+
+/// Returns true if the mutation of the original instruction cannot change the program behavior
+using EquivalenceRule = std::function<bool(MutatorKind kind, llvm::Instruction &instruction)>;
+
+/// Removes the mutants that are equivalent by construction, e.g. x + 0 replaced with x - 0,
+/// before they are compiled. Each rule only looks at the original instruction, so the filter
+/// is cheap enough to run on every mutation point.
+class EquivalentMutationFilter : public MutationFilter {
+public:
+  /// Registers the built-in rules
+  EquivalentMutationFilter();
+
+  void addRule(std::string ruleName, EquivalenceRule rule);
+  bool shouldSkip(MutationPoint *point) override;
+  std::string name() override;
+  /// Reports how many mutants each rule removed since the previous report
+  void reportStatistics(Diagnostics &diagnostics) override;
+
+private:
+  struct Rule {
+    Rule(std::string name, EquivalenceRule matches)
+        : name(std::move(name)), matches(std::move(matches)), pruned(0) {}
+    std::string name;
+    EquivalenceRule matches;
+    std::atomic<size_t> pruned;
+  };
+  std::vector<std::unique_ptr<Rule>> rules;
+};
+
+} // namespace mull
@@ -9,12 +9,13 @@ class MutationPoint;
 
 class JunkMutationFilter : public MutationFilter {
 public:
-  explicit JunkMutationFilter(JunkDetector &junkDetector);
+  explicit JunkMutationFilter(JunkDetector &junkDetector, std::string name = "junk");
   bool shouldSkip(MutationPoint *point) override;
   std::string name() override;
 
 private:
   JunkDetector &junkDetector;
+  std::string filterName;
 };
 
 } // namespace mull
\ No newline at end of file
@@ -6,12 +6,15 @@
 
 namespace mull {
 
+class Diagnostics;
 class MutationPoint;
 
 class MutationFilter : virtual public Filter {
 public:
   virtual bool shouldSkip(MutationPoint *point) = 0;
   virtual std::string name() = 0;
+  /// Called after the filter is applied to all mutation points
+  virtual void reportStatistics(Diagnostics &diagnostics) {}
   virtual ~MutationFilter() {};
 };
 
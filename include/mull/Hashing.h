@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string>
+
+namespace llvm {
+class MD5;
+}
+
+namespace mull {
+
+/// Finishes the hash and returns it as a hex string
+std::string hexDigest(llvm::MD5 &hash);
+
+} // namespace mull
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "mull/JunkDetection/CXX/CompilationDatabase.h"
+#include "mull/JunkDetection/CXX/SharedPreambles.h"
 #include "mull/SourceLocation.h"
 
 #include <clang/Frontend/ASTUnit.h>
@@ -27,6 +28,8 @@ public:
   bool isInSystemHeader(clang::SourceLocation &location);
 
   clang::Decl *getDecl(clang::SourceLocation &location);
+  /// The absolute paths of the files the unit was parsed from, including the unit itself
+  std::vector<std::string> getFiles();
 
 private:
   void recordDeclarations();
@@ -47,15 +50,32 @@ public:
 
   ThreadSafeASTUnit *findAST(const mull::SourceLocation &sourceLocation);
   ThreadSafeASTUnit *findAST(const std::string &sourceFile);
+  /// The file parsed for the source location, empty if there is none
+  std::string findUnitFile(const mull::SourceLocation &sourceLocation);
+  /// The files the unit depends on, without the temporary files used to parse it
+  std::vector<std::string> findDependencies(const std::string &sourceFile);
+  const CompilationDatabase::Flags &compilationFlagsForFile(const std::string &sourceFile) const;
 
   void setAST(const std::string &sourceFile, std::unique_ptr<ThreadSafeASTUnit> astUnit);
 private:
+  /// Each file is parsed once, by the first thread asking for it. The threads asking for the
+  /// same file wait for it, the threads asking for other files do not.
+  struct ASTSlot {
+    std::once_flag parsed;
+    std::unique_ptr<ThreadSafeASTUnit> ast;
+  };
+
+  ASTSlot &findSlot(const std::string &sourceFile);
+  std::unique_ptr<ThreadSafeASTUnit> parseAST(const std::string &sourceFile);
+
   Diagnostics &diagnostics;
+  /// Guards the map only, the parsing happens outside of it
   std::mutex mutex;
   std::mutex mutantNodesMutex;
 
   CompilationDatabase compilationDatabase;
-  std::map<std::string, std::unique_ptr<ThreadSafeASTUnit>> astUnits;
+  SharedPreambles sharedPreambles;
+  std::map<std::string, std::unique_ptr<ASTSlot>> astUnits;
 };
 
 } // namespace mull
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "mull/JunkDetection/JunkDetector.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mull {
+
+class ASTStorage;
+class Diagnostics;
+
+/// Keeps the verdicts of the junk detector between runs, so that the units that did not change
+/// are not parsed again.
+/// The verdicts of a unit are reused only if the contents of the unit and of every file it
+/// includes, its compilation flags, and the version of Mull are the same as when they were
+/// stored.
+class CachedJunkDetector : public JunkDetector {
+public:
+  CachedJunkDetector(Diagnostics &diagnostics, ASTStorage &astStorage, JunkDetector &junkDetector,
+                     std::string databasePath);
+
+  void load();
+  void save();
+
+  bool isJunk(MutationPoint *point) override;
+
+  const std::string &getDatabasePath() const;
+
+private:
+  struct Verdict {
+    bool junk;
+    int endLine;
+    int endColumn;
+  };
+  struct Unit {
+    std::string flagsHash;
+    std::vector<std::pair<std::string, std::string>> fileHashes;
+  };
+  /// Each unit is checked against the stored hashes once per run
+  struct UnitState {
+    std::once_flag checked;
+    bool upToDate = false;
+    std::once_flag recorded;
+  };
+
+  UnitState &findState(const std::string &unit);
+  bool isUpToDate(const std::string &unit);
+  void recordUnit(const std::string &unit);
+  std::string flagsHash(const std::string &unit);
+  std::string fileHash(const std::string &path);
+
+  Diagnostics &diagnostics;
+  ASTStorage &astStorage;
+  JunkDetector &junkDetector;
+  std::string databasePath;
+
+  /// Filled by load, read only afterwards
+  std::map<std::string, Unit> units;
+  std::map<std::pair<std::string, std::string>, Verdict> verdicts;
+
+  std::mutex mutex;
+  std::map<std::string, std::unique_ptr<UnitState>> states;
+  std::map<std::string, std::string> fileHashes;
+  std::map<std::string, Unit> newUnits;
+  std::map<std::pair<std::string, std::string>, Verdict> newVerdicts;
+  std::atomic<size_t> reused;
+};
+
+} // namespace mull
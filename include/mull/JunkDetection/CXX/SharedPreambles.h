@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mull {
+
+class Diagnostics;
+
+/// Precompiles the preamble of a translation unit (the #include and #define lines it starts
+/// with) once it turns out to be shared by several units in the same directory compiled with
+/// the same flags, so that the headers are parsed once for all of them.
+/// The units using a shared preamble are parsed from memory with their own preamble replaced
+/// with spaces, which keeps the source locations intact.
+class SharedPreambles {
+public:
+  explicit SharedPreambles(Diagnostics &diagnostics);
+  ~SharedPreambles();
+
+  /// Returns the flags making the unit use the shared preamble, empty if it has to be parsed
+  /// on its own. Every call after the first one for the same preamble is a hit.
+  /// On a hit the unit must be parsed from the blanked contents instead of the file.
+  std::vector<std::string> flagsFor(const std::string &sourceFile,
+                                    const std::vector<std::string> &flags,
+                                    std::string &blankedContents);
+  /// The unit cannot be parsed with the shared preamble, it is not offered again
+  void discard(const std::string &sourceFile, const std::vector<std::string> &flags);
+  /// Whether the file is one of the precompiled headers
+  bool isTemporary(const std::string &path);
+
+private:
+  struct Preamble {
+    std::once_flag built;
+    size_t units = 0;
+    std::atomic<bool> usable{ false };
+    std::string pchPath;
+  };
+
+  bool buildPCH(const std::string &sourceFile, const std::vector<std::string> &flags,
+                const std::string &text, Preamble &preamble);
+
+  Diagnostics &diagnostics;
+  std::mutex mutex;
+  std::map<std::string, std::unique_ptr<Preamble>> preambles;
+  std::vector<std::string> temporaryFiles;
+};
+
+} // namespace mull
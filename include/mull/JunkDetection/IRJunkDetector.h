@@ -0,0 +1,17 @@
+#pragma once
+
+#include "mull/JunkDetection/JunkDetector.h"
+
+namespace mull {
+
+class MutationPoint;
+
+/// Detects junk by looking at the mutated instruction only, without parsing the sources.
+/// Cheap enough to run before CXXJunkDetector, so that the ASTs are searched only for the
+/// mutations that may make sense.
+class IRJunkDetector : public JunkDetector {
+public:
+  bool isJunk(MutationPoint *point) override;
+};
+
+} // namespace mull
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mull {
+
+class Diagnostics;
+
+/// Remembers which tests killed each mutant the last time all of its tests ran.
+class KillMatrix {
+public:
+  KillMatrix(Diagnostics &diagnostics, std::string databasePath);
+
+  void load();
+  void save();
+  bool empty() const;
+
+  /// The row of a mutant is replaced as a whole on save, so all of its tests must be recorded
+  void recordRun(const std::string &mutant, const std::string &test, bool killed);
+
+  /// Mutant B subsumes mutant A if some test kills B, and every test that kills B kills A too.
+  /// Of the mutants killed by the same tests, the first one subsumes the others.
+  /// Maps each subsumed mutant to the mutants that subsume it but are not subsumed themselves.
+  std::unordered_map<std::string, std::vector<std::string>>
+  subsumedMutants(const std::vector<std::string> &mutants) const;
+
+  const std::string &getDatabasePath() const;
+
+private:
+  Diagnostics &diagnostics;
+  std::string databasePath;
+  /// Read-only once loaded. A mutant that survived all of its tests has an empty set
+  std::unordered_map<std::string, std::set<std::string>> killingTests;
+
+  std::mutex mutex;
+  std::map<std::string, std::map<std::string, bool>> newRows;
+};
+
+} // namespace mull
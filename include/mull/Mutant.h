@@ -21,6 +21,8 @@ public:
   const SourceLocation &getEndLocation() const;
   const std::string &getMutatorIdentifier() const;
   bool isCovered() const;
+  /// Reachability probes may find that a covered mutant is never executed by the tests
+  void setCovered(bool isCovered);
 
   /// needed by AST search
   void setMutatorKind(MutatorKind kind);
@@ -3,16 +3,28 @@
 #include "mull/Config/Configuration.h"
 #include "mull/Diagnostics/Diagnostics.h"
 #include "mull/MutationResult.h"
+#include "mull/Parallelization/Tasks/TestCoverageTask.h"
 #include "mull/Toolchain/Runner.h"
 
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 namespace mull {
 
+class ThreadPool;
+class TestFramework;
+class KillMatrix;
+class ReachabilitySlots;
+struct TestSelection;
+
 class MutantRunner {
 public:
-  MutantRunner(Diagnostics &diagnostics, const Configuration &configuration);
+  /// Given the reachability slots, the baseline run marks the mutants it never reaches
+  /// as not covered
+  MutantRunner(Diagnostics &diagnostics, const Configuration &configuration,
+               ThreadPool *threadPool = nullptr,
+               const ReachabilitySlots *reachabilitySlots = nullptr);
   std::vector<std::unique_ptr<MutationResult>>
   runMutants(const std::string &executable, std::vector<std::unique_ptr<Mutant>> &mutants);
   std::vector<std::unique_ptr<MutationResult>>
@@ -20,9 +32,31 @@ public:
              std::vector<std::unique_ptr<Mutant>> &mutants);
 
 private:
+  /// Returns false if the individual tests cannot be run, the whole test program is used then
+  bool collectCoveringTests(const std::string &executable,
+                            const std::vector<std::string> &extraArgs,
+                            const TestFramework &testFramework, CoveringTests &coveringTests,
+                            std::unordered_set<std::string> &wholeProgramMutants,
+                            std::unordered_map<std::string, long long> &durations);
+  void markUnreachedMutants(const std::string &bitmap,
+                            std::vector<std::unique_ptr<Mutant>> &mutants);
+  void executeMutants(const std::string &executable, const std::vector<std::string> &extraArgs,
+                      ExecutionResult &baseline, const TestSelection *testSelection,
+                      const std::vector<std::unique_ptr<Mutant>> &mutants,
+                      std::vector<std::unique_ptr<MutationResult>> &mutationResults);
+  /// Runs the mutants that are not subsumed by others first. A subsumed mutant runs only if
+  /// none of the mutants that subsume it is killed, otherwise its status is inferred from them.
+  void executeDominatorsFirst(const std::string &executable,
+                              const std::vector<std::string> &extraArgs, ExecutionResult &baseline,
+                              const TestSelection &testSelection, const KillMatrix &killMatrix,
+                              std::vector<std::unique_ptr<Mutant>> &mutants,
+                              std::vector<std::unique_ptr<MutationResult>> &mutationResults);
+
   Diagnostics &diagnostics;
   const Configuration &configuration;
   Runner runner;
+  ThreadPool *threadPool;
+  const ReachabilitySlots *reachabilitySlots;
 };
 
 } // namespace mull
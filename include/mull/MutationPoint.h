@@ -63,6 +63,7 @@ class MutationPoint {
   irm::IRMutation *irMutator;
   std::string userIdentifier;
   bool covered;
+  int schemataIndex;
 
   SourceLocation endLocation;
 
@@ -90,6 +91,13 @@ public:
   void setMutatedFunction(llvm::Function *function);
   llvm::Function *getMutatedFunction() const;
 
+  /// In mutant schemata mode all the mutants of a function share one mutated function,
+  /// the mutant with the given index (starting from 1) is enabled through the selector
+  void setMutantSchemata(llvm::Function *function, int index);
+  int getSchemataIndex() const;
+  std::string getSchemataSelectorName() const;
+  void applySchemataMutation(llvm::Instruction *instruction);
+
   const SourceLocation &getSourceLocation() const;
   const SourceLocation &getEndLocation() const;
 
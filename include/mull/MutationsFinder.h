@@ -13,12 +13,16 @@ struct Configuration;
 class Program;
 class ReachableFunction;
 class Diagnostics;
+class ThreadPool;
 
 class MutationsFinder {
 public:
   MutationsFinder(std::vector<std::unique_ptr<Mutator>> mutators, const Configuration &config);
   std::vector<MutationPoint *> getMutationPoints(Diagnostics &diagnostics, const Program &program,
-                                                 std::vector<FunctionUnderTest> &functions);
+                                                 std::vector<FunctionUnderTest> &functions,
+                                                 ThreadPool *threadPool = nullptr);
+  /// Must be called before the modules the mutation points belong to are released
+  void releaseMutationPoints();
 
 private:
   std::vector<std::unique_ptr<Mutator>> mutators;
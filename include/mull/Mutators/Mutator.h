@@ -36,6 +36,11 @@ public:
 
   virtual void applyMutation(llvm::Function *function, const MutationPointAddress &address,
                              irm::IRMutation *lowLevelMutation) = 0;
+  /// True if the mutation only changes the instruction at the mutation point, so it can be
+  /// applied to a copy of that instruction (see mutant schemata)
+  virtual bool isInstructionLocal() const {
+    return false;
+  }
   virtual std::vector<MutationPoint *> getMutations(Bitcode *bitcode,
                                                     const FunctionUnderTest &function) = 0;
 
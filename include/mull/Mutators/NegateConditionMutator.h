@@ -44,6 +44,9 @@ public:
   void applyMutation(llvm::Function *function,
                      const MutationPointAddress &address,
                      irm::IRMutation *lowLevelMutation) override;
+  bool isInstructionLocal() const override {
+    return true;
+  }
 
   std::vector<MutationPoint *>
   getMutations(Bitcode *bitcode, const FunctionUnderTest &function) override;
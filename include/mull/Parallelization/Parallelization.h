@@ -2,15 +2,20 @@
 
 #include "mull/Parallelization/Progress.h"
 #include "mull/Parallelization/TaskExecutor.h"
+#include "mull/Parallelization/ThreadPool.h"
 
 #include "mull/Parallelization/Tasks/ApplyMutationTask.h"
 #include "mull/Parallelization/Tasks/BitcodeLoadingTask.h"
 #include "mull/Parallelization/Tasks/DryRunMutantExecutionTask.h"
+#include "mull/Parallelization/Tasks/EquivalentMutantsTask.h"
 #include "mull/Parallelization/Tasks/FunctionFilterTask.h"
 #include "mull/Parallelization/Tasks/InstructionSelectionTask.h"
+#include "mull/Parallelization/Tasks/LoadBitcodeFromBinaryTask.h"
 #include "mull/Parallelization/Tasks/LoadObjectFilesTask.h"
+#include "mull/Parallelization/Tasks/MaterializeFunctionsTask.h"
 #include "mull/Parallelization/Tasks/MutantExecutionTask.h"
 #include "mull/Parallelization/Tasks/MutantPreparationTasks.h"
 #include "mull/Parallelization/Tasks/MutationFilterTask.h"
 #include "mull/Parallelization/Tasks/OriginalCompilationTask.h"
 #include "mull/Parallelization/Tasks/SearchMutationPointsTask.h"
+#include "mull/Parallelization/Tasks/TestCoverageTask.h"
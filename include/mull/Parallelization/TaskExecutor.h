@@ -1,13 +1,16 @@
 #pragma once
 
+#include <atomic>
 #include <cassert>
 #include <functional>
+#include <future>
+#include <iterator>
 #include <string>
-#include <thread>
 #include <utility>
 #include <vector>
 
 #include "Progress.h"
+#include "ThreadPool.h"
 #include "mull/Metrics/MetricsMeasure.h"
 
 namespace mull {
@@ -17,23 +20,34 @@ class Diagnostics;
 std::vector<int> taskBatches(size_t itemsCount, size_t tasks);
 void printTimeSummary(Diagnostics &diagnostics, MetricsMeasure measure);
 
+/// StaticBatches splits the input into one contiguous batch per task upfront.
+/// Dynamic lets each task pick the next unprocessed item as soon as it is done with the previous
+/// one, so that a batch of slow items does not hold back the whole run.
+/// Both produce the output in the order of the input.
+enum class TaskScheduling { StaticBatches, Dynamic };
+
 template <typename Task> class TaskExecutor {
 public:
   using In = typename Task::In;
   using Out = typename Task::Out;
   TaskExecutor(Diagnostics &diagnostics, std::string name, In &in, Out &out,
-               std::vector<Task> tasks)
-      : diagnostics(diagnostics), in(in), out(out), tasks(std::move(tasks)), name(std::move(name)) {
-  }
+               std::vector<Task> tasks,
+               TaskScheduling scheduling = TaskScheduling::StaticBatches)
+      : diagnostics(diagnostics), in(in), out(out), tasks(std::move(tasks)), name(std::move(name)),
+        scheduling(scheduling) {}
 
-  void execute() {
+  /// Runs the tasks on the threads of the pool if one is given, otherwise on dedicated threads
+  void execute(ThreadPool *threadPool = nullptr) {
     if (tasks.empty() || in.empty()) {
       return;
     }
 
+    pool = threadPool;
     measure.start();
     if (tasks.size() == 1 || in.size() == 1) {
       executeSequentially();
+    } else if (scheduling == TaskScheduling::Dynamic) {
+      executeDynamically();
     } else {
       executeInParallel();
     }
@@ -42,36 +56,74 @@ public:
   }
 
 private:
+  std::future<void> spawn(std::function<void()> job) {
+    if (pool) {
+      return pool->submit(std::move(job));
+    }
+    return std::async(std::launch::async, std::move(job));
+  }
+
   void executeInParallel() {
     assert(tasks.size() != 1);
     assert(in.size() != 1);
     auto workers = std::min(in.size(), tasks.size());
 
     auto batches = taskBatches(in.size(), workers);
-    std::vector<std::thread> threads;
-    std::vector<Out> storages;
-
-    storages.reserve(workers);
-    counters.reserve(workers);
+    std::vector<std::future<void>> jobs;
+    std::vector<Out> storages(workers);
 
+    counters.resize(workers);
     auto end = in.begin();
     for (unsigned i = 0; i < workers; i++) {
-      int group = batches[i];
-      storages.push_back(Out());
-      counters.push_back(progress_counter());
-
       auto begin = end;
-      std::advance(end, group);
-      std::thread t(
-          std::move(tasks[i]), begin, end, std::ref(storages.back()), std::ref(counters.back()));
-      threads.push_back(std::move(t));
+      std::advance(end, batches[i]);
+      jobs.push_back(spawn([this, i, begin, end, &storages]() {
+        tasks[i](begin, end, storages[i], counters[i]);
+      }));
+    }
+
+    progress_reporter reporter{ diagnostics, name, counters, in.size(), workers };
+    reporter();
+
+    for (auto &job : jobs) {
+      job.get();
+    }
+
+    for (auto &storage : storages) {
+      for (auto &m : storage) {
+        out.push_back(std::move(m));
+      }
+    }
+  }
+
+  void executeDynamically() {
+    assert(tasks.size() != 1);
+    assert(in.size() != 1);
+    auto workers = std::min(in.size(), tasks.size());
+
+    /// Each item gets its own storage so that the output order does not depend on which task
+    /// processed the item
+    std::vector<Out> storages(in.size());
+    std::atomic<size_t> nextItem(0);
+    std::vector<std::future<void>> jobs;
+
+    counters.resize(workers);
+    for (unsigned i = 0; i < workers; i++) {
+      jobs.push_back(spawn([this, i, &storages, &nextItem]() {
+        auto &task = tasks[i];
+        auto &counter = counters[i];
+        for (size_t index = nextItem++; index < in.size(); index = nextItem++) {
+          auto begin = std::next(in.begin(), index);
+          task(begin, std::next(begin), storages[index], counter);
+        }
+      }));
     }
 
-    std::thread reporter(progress_reporter{ diagnostics, name, counters, in.size(), workers });
-    threads.push_back(std::move(reporter));
+    progress_reporter reporter{ diagnostics, name, counters, in.size(), workers };
+    reporter();
 
-    for (auto &t : threads) {
-      t.join();
+    for (auto &job : jobs) {
+      job.get();
     }
 
     for (auto &storage : storages) {
@@ -86,10 +138,11 @@ private:
     auto &task = tasks.front();
 
     counters.push_back(progress_counter());
-    std::thread reporter(progress_reporter{ diagnostics, name, counters, in.size(), 1 });
+    progress_reporter reporter{ diagnostics, name, counters, in.size(), 1 };
+    auto reporting = spawn(reporter);
 
     task(in.begin(), in.end(), out, std::ref(counters.back()));
-    reporter.join();
+    reporting.get();
   }
 
   Diagnostics &diagnostics;
@@ -99,6 +152,8 @@ private:
   std::vector<progress_counter> counters{};
   MetricsMeasure measure;
   std::string name;
+  TaskScheduling scheduling;
+  ThreadPool *pool{};
 };
 
 class SingleTaskTag {};
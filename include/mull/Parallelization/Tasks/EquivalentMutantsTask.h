@@ -0,0 +1,37 @@
+#pragma once
+
+#include "mull/Bitcode.h"
+
+#include <string>
+#include <vector>
+
+namespace mull {
+
+class MutationPoint;
+class progress_counter;
+
+struct MutationPointFingerprint {
+  MutationPoint *point;
+  /// Equal for the points whose mutated functions optimize to the same code
+  std::string fingerprint;
+  /// The mutated function optimizes to the same code as the original one
+  bool equivalent;
+};
+
+/// Trivial compiler equivalence: optimizes a copy of each mutated function and of its original
+/// function, and compares the code. Must run after the mutations are applied and before anything
+/// is inserted into the original functions (e.g. reachability probes).
+/// The points that share a schemata function are not fingerprinted.
+class EquivalentMutantsTask {
+public:
+  using In = std::vector<std::unique_ptr<Bitcode>>;
+  using Out = std::vector<MutationPointFingerprint>;
+  using iterator = In::const_iterator;
+
+  EquivalentMutantsTask() = default;
+
+  void operator()(iterator begin, iterator end, Out &storage, progress_counter &counter);
+  static void fingerprintMutants(Bitcode &bitcode, Out &storage);
+};
+
+} // namespace mull
@@ -1,13 +1,10 @@
 #pragma once
 
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/Support/MemoryBuffer.h>
 
 #include <vector>
 
-namespace ebc {
-class EmbeddedFile;
-}
-
 namespace mull {
 
 class Bitcode;
@@ -16,7 +13,8 @@ class Diagnostics;
 
 class LoadBitcodeFromBinaryTask {
 public:
-  using In = std::vector<std::unique_ptr<ebc::EmbeddedFile>>;
+  /// Raw bitcode embedded into the executable, must outlive the loaded modules
+  using In = std::vector<llvm::MemoryBufferRef>;
   using Out = std::vector<std::unique_ptr<mull::Bitcode>>;
   using iterator = In::iterator;
 
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "mull/Bitcode.h"
+#include <unordered_set>
+#include <vector>
+
+namespace mull {
+class Diagnostics;
+class progress_counter;
+
+/// Parses the bodies of lazily loaded functions
+class MaterializeFunctionsTask {
+public:
+  using In = std::vector<std::unique_ptr<Bitcode>>;
+  using Out = std::vector<int>;
+  using iterator = In::const_iterator;
+
+  /// Materializes whole modules if 'functions' is null
+  MaterializeFunctionsTask(Diagnostics &diagnostics,
+                           const std::unordered_set<llvm::Function *> *functions);
+
+  void operator()(iterator begin, iterator end, Out &storage, progress_counter &counter);
+
+private:
+  Diagnostics &diagnostics;
+  const std::unordered_set<llvm::Function *> *functions;
+};
+} // namespace mull
@@ -2,13 +2,35 @@
 
 #include "mull/Mutant.h"
 #include "mull/MutationResult.h"
+#include "mull/Parallelization/Tasks/TestCoverageTask.h"
+
+#include <unordered_set>
 
 namespace mull {
 
 class progress_counter;
 class Diagnostics;
+class ForkServer;
+class KillMatrix;
+class Runner;
+class TestFramework;
+class TestHistory;
+class Worker;
 struct Configuration;
 
+struct TestSelection {
+  const TestFramework &testFramework;
+  const CoveringTests &coveringTests;
+  /// Reached by tests that fail on their own, these mutants run against the whole program
+  const std::unordered_set<std::string> &wholeProgramMutants;
+  /// Running times of the tests on their own
+  const std::unordered_map<std::string, long long> &durations;
+  /// If set, the tests run one by one in the order of their kill history until the first failure
+  TestHistory *testHistory;
+  /// If set, the tests run one by one without stopping, and each of them is recorded
+  KillMatrix *killMatrix;
+};
+
 class MutantExecutionTask {
 public:
   using In = const std::vector<std::unique_ptr<Mutant>>;
@@ -17,15 +39,32 @@ public:
 
   MutantExecutionTask(const Configuration &configuration, Diagnostics &diagnostics,
                       const std::string &executable, ExecutionResult &baseline,
-                      const std::vector<std::string> &extraArgs);
+                      const std::vector<std::string> &extraArgs,
+                      const TestSelection *testSelection = nullptr,
+                      std::string workerCommand = std::string());
+  MutantExecutionTask(MutantExecutionTask &&) noexcept;
+  ~MutantExecutionTask();
 
   void operator()(iterator begin, iterator end, Out &storage, progress_counter &counter);
 
 private:
+  ExecutionResult runTests(Runner &runner, const Mutant &mutant,
+                           const std::vector<std::string> &tests);
+  /// Delegates to the worker if there is one
+  ExecutionResult runMutant(Runner &runner, const Mutant &mutant,
+                            const std::vector<std::string> &arguments);
+
   const Configuration &configuration;
   Diagnostics &diagnostics;
   const std::string &executable;
   ExecutionResult &baseline;
   const std::vector<std::string> &extraArgs;
+  /// If set, each mutant runs only against the tests that reach it
+  const TestSelection *testSelection;
+  /// Started on the first call and reused by the following ones
+  std::unique_ptr<ForkServer> forkServer;
+  /// Empty runs the mutants locally
+  std::string workerCommand;
+  std::unique_ptr<Worker> worker;
 };
 } // namespace mull
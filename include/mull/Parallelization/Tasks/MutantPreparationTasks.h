@@ -14,13 +14,16 @@ public:
   using Out = std::vector<int>;
   using iterator = In::const_iterator;
 
-  CloneMutatedFunctionsTask() = default;
+  explicit CloneMutatedFunctionsTask(bool mutantSchemata = false);
 
   void operator()(iterator begin, iterator end, Out &storage,
                   progress_counter &counter);
-  static void cloneFunctions(Bitcode &bitcode);
+  /// In mutant schemata mode the instruction-local mutants of a function share a single clone,
+  /// the active mutant is chosen at runtime through the selector global
+  static void cloneFunctions(Bitcode &bitcode, bool mutantSchemata = false);
 
 private:
+  bool mutantSchemata;
 };
 
 class DeleteOriginalFunctionsTask {
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "mull/ExecutionResult.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mull {
+
+class progress_counter;
+class Diagnostics;
+class TestFramework;
+struct Configuration;
+
+struct TestCoverage {
+  std::string test;
+  ExecutionResult result;
+  /// Identifiers of the mutants whose functions were called by the test
+  std::vector<std::string> mutants;
+  /// False if the probes left no readable record, then the reached mutants are unknown
+  bool coverageKnown = false;
+};
+
+/// Maps the identifier of each mutant to the tests that reach it
+using CoveringTests = std::unordered_map<std::string, std::vector<std::string>>;
+
+/// Runs each test case separately on the mutated program with no mutants enabled and collects
+/// the mutants it reaches
+class TestCoverageTask {
+public:
+  using In = const std::vector<std::string>;
+  using Out = std::vector<TestCoverage>;
+  using iterator = In::const_iterator;
+
+  TestCoverageTask(const Configuration &configuration, Diagnostics &diagnostics,
+                   const std::string &executable, const std::vector<std::string> &extraArgs,
+                   const TestFramework &testFramework);
+
+  void operator()(iterator begin, iterator end, Out &storage, progress_counter &counter);
+
+private:
+  const Configuration &configuration;
+  Diagnostics &diagnostics;
+  const std::string &executable;
+  const std::vector<std::string> &extraArgs;
+  const TestFramework &testFramework;
+};
+
+} // namespace mull
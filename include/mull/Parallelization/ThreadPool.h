@@ -0,0 +1,37 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace mull {
+
+/// A fixed set of worker threads shared by the pipeline phases, so that each phase does not
+/// pay for spawning and joining its own threads.
+/// Jobs must not wait for other jobs submitted to the same pool.
+class ThreadPool {
+public:
+  explicit ThreadPool(size_t threadsCount);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  std::future<void> submit(std::function<void()> job);
+  size_t size() const;
+
+private:
+  void work();
+
+  std::vector<std::thread> threads;
+  std::queue<std::packaged_task<void()>> jobs;
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool stopping;
+};
+
+} // namespace mull
@@ -5,6 +5,7 @@
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Module.h>
 #include <llvm/Object/ObjectFile.h>
+#include <llvm/Support/MemoryBuffer.h>
 
 #include <vector>
 
@@ -13,10 +14,17 @@ namespace mull {
 class Program {
 public:
   explicit Program(std::vector<std::unique_ptr<Bitcode>> bitcode);
+  /// Streaming mode: the modules are loaded from the buffers batch by batch and released
+  /// once they are compiled, bitcode() only holds the current batch
+  static Program fromBitcodeBuffers(std::vector<llvm::MemoryBufferRef> bitcodeBuffers);
+
   std::vector<std::unique_ptr<Bitcode>> &bitcode();
+  const std::vector<llvm::MemoryBufferRef> &bitcodeBuffers() const;
+  bool isStreaming() const;
 
 private:
   std::vector<std::unique_ptr<Bitcode>> _bitcode;
+  std::vector<llvm::MemoryBufferRef> _bitcodeBuffers;
 };
 
 } // namespace mull
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "mull/ExecutionResult.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mull {
+
+class Bitcode;
+class Diagnostics;
+class Mutant;
+class MutationPoint;
+
+/// Keeps the status of each mutant between runs.
+/// A status is reused only if no function and no global of the program changed since the
+/// mutant was run: the tests may reach the mutated code through any of them.
+class ResultCache {
+public:
+  ResultCache(Diagnostics &diagnostics, std::string databasePath);
+
+  void load();
+  void save();
+
+  /// Must be called before the functions are mutated.
+  /// In streaming mode it is called once per batch of modules.
+  void hashProgram(const std::vector<std::unique_ptr<Bitcode>> &bitcode,
+                   const std::vector<MutationPoint *> &mutationPoints);
+
+  bool lookup(const Mutant &mutant, ExecutionResult &result);
+  void store(const Mutant &mutant, const ExecutionResult &result);
+  /// How long the mutant ran last time, even if the result is outdated. Negative if unknown
+  long long previousRunningTime(const Mutant &mutant) const;
+
+  const std::string &getDatabasePath() const;
+
+private:
+  struct Entry {
+    std::string codeHash;
+    std::string programHash;
+    ExecutionStatus status;
+    long long runningTime;
+  };
+  std::string codeHash(const std::string &mutant) const;
+  const std::string &programHash();
+
+  Diagnostics &diagnostics;
+  std::string databasePath;
+  /// A mutant may come from several modules (e.g. an inline function from a header)
+  std::unordered_map<std::string, std::vector<std::string>> mutantCodeHashes;
+  /// The original code of the whole program, accumulated over the batches in streaming mode
+  std::vector<std::string> programCodeHashes;
+  std::string combinedProgramHash;
+  std::unordered_map<std::string, Entry> entries;
+  std::unordered_map<std::string, Entry> newEntries;
+};
+
+} // namespace mull
@@ -0,0 +1,31 @@
+#pragma once
+
+namespace llvm {
+class Module;
+}
+
+namespace mull {
+
+/// The fork server talks to Mull via two pipes mapped to fixed file descriptors.
+/// The numbers are high enough not to clash with the descriptors used by a test program.
+constexpr int ForkServerControlDescriptor = 198;
+constexpr int ForkServerStatusDescriptor = 199;
+
+/// Written by the fork server once it is initialized and ready to accept requests
+constexpr int ForkServerHello = 0x6d756c6c;
+constexpr unsigned ForkServerMaxIdentifierLength = 4096;
+
+/// The fork server only starts if this variable is set, otherwise the program runs as usual
+extern const char *ForkServerEnvironmentVariable;
+
+/// Inserts a static constructor that turns the program into a fork server.
+///
+/// Protocol (all integers are native 32-bit):
+///   server -> mull: hello
+///   mull -> server: length of the mutant identifier, identifier bytes
+///   server -> mull: pid of the forked child, wait status of the child
+///
+/// The child enables the requested mutant and continues normal execution of the program.
+void insertForkServer(llvm::Module &module);
+
+} // namespace mull
@@ -0,0 +1,31 @@
+#pragma once
+
+namespace llvm {
+class Function;
+class GlobalVariable;
+class LLVMContext;
+class Module;
+class StructType;
+} // namespace llvm
+
+namespace mull {
+
+/// Each module with mutants has a resolver: a function that reads the environment and points
+/// the trampolines either to the original functions or to the enabled mutants.
+/// Resolvers run once at startup, so the trampolines do not query the environment on each call.
+///
+/// All the resolvers are kept in a linked list of { void (*resolve)(), i8 *next } nodes so that
+/// they can be re-run when the set of enabled mutants changes (e.g. in a fork server child).
+
+llvm::StructType *getMutantResolverType(llvm::LLVMContext &context);
+
+/// The head of the list. Defined as weak in each module so that all of them share the same list
+llvm::GlobalVariable *getOrInsertMutantResolvers(llvm::Module &module);
+
+/// Adds a static constructor that runs the resolver and appends it to the list
+void registerMutantResolver(llvm::Module &module, llvm::Function *resolver);
+
+/// Creates a function that runs all the registered resolvers
+llvm::Function *insertResolveAllMutants(llvm::Module &module);
+
+} // namespace mull
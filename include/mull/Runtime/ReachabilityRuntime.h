@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace llvm {
+class Instruction;
+class Module;
+} // namespace llvm
+
+namespace mull {
+
+/// Names a file that the probes map into memory and use as the bitmap of the reached mutants.
+/// Without it the probes write into a private buffer.
+extern const char *ReachabilityEnvironmentVariable;
+
+/// Each covered mutation point gets a byte in the bitmap.
+/// The same mutant may come from several modules (e.g. an inline function from a header),
+/// and then it has several slots: the mutant is reached if any of them is set.
+class ReachabilitySlots {
+public:
+  size_t add(const std::string &mutant);
+  size_t size() const;
+  /// The mutants none of whose slots is set
+  std::unordered_set<std::string> unreachedMutants(const std::string &bitmap) const;
+
+private:
+  std::vector<std::string> mutants;
+};
+
+/// Inserts a probe right before each of the instructions: the probe sets the given slot.
+/// The probes must go into the copies of the original functions, so that they fire when
+/// no mutant is enabled.
+void insertReachabilityProbes(llvm::Module &module,
+                              const std::vector<std::pair<llvm::Instruction *, size_t>> &probes);
+
+} // namespace mull
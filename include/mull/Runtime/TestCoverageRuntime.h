@@ -0,0 +1,37 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class Function;
+class Module;
+} // namespace llvm
+
+namespace mull {
+
+/// Names the file the probes record the reached mutants to. Without it the probes write into
+/// a private buffer.
+extern const char *TestCoverageEnvironmentVariable;
+
+/// Each module appends a record to the file when the program starts:
+///
+///   <marker><flags count> <lines count>\n
+///   <flag index> <mutant identifier>\n   (one line per mutant)
+///   <flags>                              (one byte per trampoline)
+///
+/// The flags are then mapped into memory, so a hit is in the file as soon as it happens,
+/// even if the test never exits normally (e.g. abort, _exit, or a crash).
+extern const char *TestCoverageMarker;
+
+/// Inserts a flag into each of the given trampolines, the flag is set whenever the trampoline
+/// is called. The mutants of a trampoline are reached once its flag is set.
+void insertTestCoverage(llvm::Module &module,
+                        const std::map<llvm::Function *, std::vector<std::string>> &mutants);
+
+/// Extracts the identifiers of the reached mutants from the file written by the probes.
+/// Returns false if the file is malformed
+bool parseTestCoverage(const std::string &contents, std::vector<std::string> &identifiers);
+
+} // namespace mull
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace mull {
+
+class Diagnostics;
+
+namespace sqlite {
+
+/// Runs the statements, returns false and sets the error on the first failure
+bool execute(sqlite3 *database, const char *sql, std::string &error);
+/// Warns with 'Cannot update <description>' on failure
+bool execute(Diagnostics &diagnostics, sqlite3 *database, const char *sql,
+             const std::string &description);
+/// Opens or creates the database and its tables. Warns and returns nullptr on failure.
+sqlite3 *openDatabase(Diagnostics &diagnostics, const std::string &path, const char *createTables,
+                      const std::string &description);
+/// Empty for NULL
+std::string columnText(sqlite3_stmt *statement, int column);
+
+} // namespace sqlite
+} // namespace mull
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mull {
+
+class Diagnostics;
+class Mutant;
+class Result;
+
+/// Estimated cost of running a mutant, in arbitrary but consistent units.
+/// It must only depend on the mutant itself, not on anything measured or cached on the machine.
+using MutantCost = std::function<long long(const Mutant &)>;
+
+/// The complete list of mutants the shards are selected from
+struct MutantSet {
+  size_t count = 0;
+  /// Hash of the sorted identifiers
+  std::string hash;
+};
+
+MutantSet describeMutants(const std::vector<std::unique_ptr<Mutant>> &mutants);
+
+/// Splits the sorted mutants into shardCount shards of roughly equal total cost and keeps the
+/// ones that belong to shardIndex. Every machine computes the same partitioning from the same
+/// input, so the shards never overlap and together cover all the mutants.
+/// The relative order of the mutants is preserved.
+std::vector<std::unique_ptr<Mutant>> selectShard(std::vector<std::unique_ptr<Mutant>> mutants,
+                                                 const MutantCost &cost, unsigned shardIndex,
+                                                 unsigned shardCount);
+
+/// <directory>/<name>-shard-<index>-of-<count>.sqlite, the name defaults to 'mull'
+std::string partialResultPath(const std::string &directory, const std::string &name,
+                              unsigned shardIndex, unsigned shardCount);
+
+/// Saves the mutants and their results so that mull-merge can assemble the complete result.
+/// The set of all the mutants is saved as well, so that the gaps can be found
+void writePartialResult(Diagnostics &diagnostics, const std::string &path, const Result &result,
+                        unsigned shardIndex, unsigned shardCount, const MutantSet &allMutants);
+
+/// Combines the partial results of all the shards. Fails if the shards were selected from
+/// different sets of mutants, or if a shard or a mutant is missing. Warns about duplicates
+std::unique_ptr<Result> mergePartialResults(Diagnostics &diagnostics,
+                                            const std::vector<std::string> &paths);
+
+} // namespace mull
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mull {
+
+class Diagnostics;
+
+/// Remembers which tests killed which mutants across runs.
+/// Mutants are keyed by their user identifiers, which do not change between builds.
+class TestHistory {
+public:
+  TestHistory(Diagnostics &diagnostics, std::string databasePath);
+
+  void load();
+  void save();
+
+  /// Orders the tests by the kill probability per millisecond: the tests that killed the mutant
+  /// before come first, then the tests that kill many other mutants, the fast ones first
+  std::vector<std::string>
+  prioritize(const std::string &mutant, std::vector<std::string> tests,
+             const std::unordered_map<std::string, long long> &durations) const;
+  void recordRun(const std::string &mutant, const std::string &test, bool killed);
+
+  const std::string &getDatabasePath() const;
+
+private:
+  struct Record {
+    long long runs = 0;
+    long long kills = 0;
+  };
+  double killProbability(const std::string &mutant, const std::string &test) const;
+
+  Diagnostics &diagnostics;
+  std::string databasePath;
+  /// Read-only once loaded, so prioritization does not need the lock
+  std::map<std::pair<std::string, std::string>, Record> history;
+  std::unordered_map<std::string, Record> testTotals;
+
+  std::mutex mutex;
+  std::map<std::pair<std::string, std::string>, Record> newRuns;
+};
+
+} // namespace mull
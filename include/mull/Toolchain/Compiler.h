@@ -3,9 +3,20 @@
 #include "llvm/Object/Binary.h"
 #include "llvm/Object/ObjectFile.h"
 
+#include "mull/Config/ConfigurationOptions.h"
+#include "mull/Toolchain/ObjectCache.h"
+
+#include <llvm/Support/CodeGen.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 namespace llvm {
 
 class Module;
+class Target;
 class TargetMachine;
 
 } // namespace llvm
@@ -16,13 +27,51 @@ class Bitcode;
 class Diagnostics;
 struct Configuration;
 
+/// What the codegen does under a profile
+struct CodegenPipeline {
+  llvm::CodeGenOpt::Level optimizationLevel;
+  bool fastInstructionSelection;
+  /// Only if the program runs on the machine that compiles it
+  bool hostCPU;
+  bool stripDebugInfo;
+  /// O2 function passes on the mutated functions
+  bool optimizeMutatedFunctions;
+};
+
+/// Auto is resolved to Default, the driver should have resolved it before
+CodegenPipeline codegenPipeline(CodegenProfile profile);
+
+/// Estimated times of compiling the program and of running all of the mutants, in milliseconds
+struct CodegenEstimate {
+  long long compilationTime;
+  /// Negative if unknown, e.g. when the sanity check run is skipped
+  long long executionTime;
+};
+
+/// Resolves the Auto profile: the optimizations pay off only if the mutants run longer than
+/// they compile. Without an execution time, compiling fast is the safe bet.
+CodegenProfile selectCodegenProfile(const CodegenEstimate &estimate);
+
 class Compiler {
 public:
   explicit Compiler(Diagnostics &diagnostics, const Configuration &configuration);
+  ~Compiler();
   std::string compileBitcode(const Bitcode &bitcode);
+  void setCodegenProfile(CodegenProfile profile);
 
 private:
+  /// Creating a TargetMachine is expensive, so each thread creates one per triple and reuses it.
+  /// TargetMachine is not thread-safe, hence it is not shared between the threads.
+  llvm::TargetMachine *getTargetMachine(const llvm::Target &target, const std::string &triple,
+                                        const std::string &CPU, const std::string &features,
+                                        CodegenProfile profile);
+
   Diagnostics &diagnostics;
   const Configuration &configuration;
+  ObjectCache objectCache;
+  CodegenProfile codegenProfile;
+  std::mutex targetMachinesMutex;
+  std::map<std::pair<std::thread::id, std::string>, std::unique_ptr<llvm::TargetMachine>>
+      targetMachines;
 };
 } // namespace mull
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "mull/ExecutionResult.h"
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace mull {
+
+class Diagnostics;
+
+/// Client side of the fork server inserted by insertForkServer.
+/// The program is started once, and then each mutant runs in a child forked by the program itself,
+/// so that the startup costs (dynamic loading, static initializers) are paid only once.
+/// The output of the mutants is not captured.
+class ForkServer {
+public:
+  explicit ForkServer(Diagnostics &diagnostics);
+  ~ForkServer();
+
+  /// Returns false if the program cannot be started or does not contain the fork server
+  bool start(const std::string &program, const std::vector<std::string> &arguments,
+             long long int timeout);
+  /// Returns false if the server is gone, the result should be obtained by other means then
+  bool runMutant(const std::string &identifier, long long int timeout, ExecutionResult &result);
+  bool isRunning() const;
+  void stop();
+
+private:
+  Diagnostics &diagnostics;
+  pid_t serverPid;
+  int controlDescriptor;
+  int statusDescriptor;
+};
+
+} // namespace mull
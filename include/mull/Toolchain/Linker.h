@@ -14,6 +14,11 @@ public:
   std::string linkObjectFiles(const std::vector<std::string> &objects);
 
 private:
+  /// Returns false if Mull is built without lld, or if the flags of -linker cannot be translated
+  /// into the flags of lld. The objects are still read from the disk, only the spawn of the
+  /// linker is saved. lld cannot be interrupted, so -linker-timeout does not apply.
+  bool linkInProcess(const std::vector<std::string> &objects, const std::string &outputFile);
+
   const Configuration &configuration;
   Diagnostics &diagnostics;
 };
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+namespace llvm {
+class Module;
+} // namespace llvm
+
+namespace mull {
+
+class Diagnostics;
+
+/// On-disk cache of object files keyed by the content of the module they were compiled from.
+/// Modules without mutants rarely change between runs, so most of them can skip the codegen.
+class ObjectCache {
+public:
+  /// The cache is disabled if the directory is empty
+  ObjectCache(Diagnostics &diagnostics, std::string directory);
+
+  bool isEnabled() const;
+
+  /// The options must contain everything that affects the codegen besides the module itself
+  std::string getKey(const llvm::Module &module, const std::string &options) const;
+
+  /// Returns a copy of the cached object file, or an empty string if there is no such object
+  std::string getObject(const std::string &key, const std::string &destination) const;
+  void putObject(const std::string &key, const std::string &objectFile) const;
+
+private:
+  std::string getObjectPath(const std::string &key) const;
+
+  Diagnostics &diagnostics;
+  std::string directory;
+};
+
+} // namespace mull
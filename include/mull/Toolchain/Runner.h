@@ -3,6 +3,7 @@
 #include "mull/ExecutionResult.h"
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace mull {
@@ -12,10 +13,13 @@ class Diagnostics;
 class Runner {
 public:
   explicit Runner(Diagnostics &diagnostics);
-  ExecutionResult runProgram(const std::string &program, const std::vector<std::string> &arguments,
-                             const std::vector<std::string> &environment, long long int timeout,
-                             bool captureOutput,
-                             std::optional<std::string> optionalWorkingDirectory);
+  /// The environment variables are set to 1, the variables with other values go to
+  /// environmentValues
+  ExecutionResult runProgram(
+      const std::string &program, const std::vector<std::string> &arguments,
+      const std::vector<std::string> &environment, long long int timeout, bool captureOutput,
+      std::optional<std::string> optionalWorkingDirectory,
+      const std::vector<std::pair<std::string, std::string>> &environmentValues = {});
 
 private:
   Diagnostics &diagnostics;
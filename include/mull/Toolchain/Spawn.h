@@ -0,0 +1,12 @@
+#pragma once
+
+#include <sys/types.h>
+
+namespace mull {
+
+/// Creates a pipe whose ends are never inherited by the processes spawned on other threads
+bool createPipe(int descriptors[2]);
+/// Must be used instead of fork() by everyone who creates pipes with createPipe
+pid_t forkProcess();
+
+} // namespace mull
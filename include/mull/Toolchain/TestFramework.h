@@ -0,0 +1,33 @@
+#pragma once
+
+#include "mull/Config/ConfigurationOptions.h"
+
+#include <string>
+#include <vector>
+
+namespace mull {
+
+class Runner;
+
+/// Lists and selects the individual test cases of a program built with GoogleTest, Catch2,
+/// or doctest
+class TestFramework {
+public:
+  explicit TestFramework(TestFrameworkKind kind);
+
+  /// Arguments that make the program print the names of its test cases instead of running them.
+  /// The alternatives are tried in order, as the versions of a framework may differ.
+  std::vector<std::vector<std::string>> listArguments() const;
+  std::vector<std::string> parseTestList(const std::string &output) const;
+  /// Returns no tests if the program accepts none of the listing arguments
+  std::vector<std::string> listTests(Runner &runner, const std::string &executable,
+                                     const std::vector<std::string> &extraArgs,
+                                     long long timeout) const;
+  /// Arguments that make the program run only the given test cases
+  std::vector<std::string> selectArguments(const std::vector<std::string> &tests) const;
+
+private:
+  TestFrameworkKind kind;
+};
+
+} // namespace mull
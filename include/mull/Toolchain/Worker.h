@@ -0,0 +1,37 @@
+#pragma once
+
+#include "mull/ExecutionResult.h"
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+namespace mull {
+
+class Diagnostics;
+
+/// Client side of the worker protocol (see WorkerProtocol.h).
+/// The command is run by /bin/sh, so it may wrap the worker into any transport.
+/// A worker runs one mutant at a time, several workers make a pool.
+class Worker {
+public:
+  explicit Worker(Diagnostics &diagnostics);
+  ~Worker();
+
+  /// Returns false if the worker cannot be started or does not speak the protocol
+  bool start(const std::string &command, const std::string &executable, bool captureOutput,
+             long long int timeout);
+  /// Returns false if the worker is gone, the result should be obtained by other means then
+  bool runMutant(const std::string &identifier, const std::vector<std::string> &arguments,
+                 long long int timeout, ExecutionResult &result);
+  bool isRunning() const;
+  void stop();
+
+private:
+  Diagnostics &diagnostics;
+  std::string command;
+  pid_t workerPid;
+  int requestDescriptor;
+  int resultDescriptor;
+};
+
+} // namespace mull
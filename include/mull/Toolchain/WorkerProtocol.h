@@ -0,0 +1,44 @@
+#pragma once
+
+#include "mull/ExecutionResult.h"
+#include <string>
+#include <vector>
+
+namespace mull {
+
+class Diagnostics;
+
+/// Mutants can be executed by external workers: processes that read requests from stdin and
+/// write the results to stdout. A worker may run on another machine behind any transport
+/// (e.g. 'ssh agent mull-worker'), as long as the executable is available there at the same path.
+///
+/// Each message is a frame: a 4-byte big-endian payload length followed by the payload.
+/// The payload is a sequence of fields, each one is a 4-byte big-endian length followed by
+/// the bytes. The first field is the kind of the message:
+///
+///   worker -> mull: hello <version>
+///   mull -> worker: program <executable> <capture output: 0 or 1>
+///   mull -> worker: run <mutant> <timeout, ms> <argument>...
+///   worker -> mull: result <mutant> <status> <exit status> <running time, ms> <stdout> <stderr>
+///
+/// The worker greets once it is ready, answers each 'run' with a 'result',
+/// and exits when its input is closed.
+using WorkerFrame = std::vector<std::string>;
+
+extern const char *WorkerProtocolVersion;
+
+/// Timeout is in milliseconds, negative waits forever
+bool readWorkerFrame(int descriptor, WorkerFrame &frame, long long int timeout);
+bool writeWorkerFrame(int descriptor, const WorkerFrame &frame);
+
+std::string encodeWorkerFrame(const WorkerFrame &frame);
+/// Returns false if the payload is malformed
+bool decodeWorkerFrame(const std::string &payload, WorkerFrame &frame);
+
+WorkerFrame makeResultFrame(const std::string &mutant, const ExecutionResult &result);
+bool parseResultFrame(const WorkerFrame &frame, std::string &mutant, ExecutionResult &result);
+
+/// The worker side of the protocol, returns once the input is closed
+void serveWorkerRequests(Diagnostics &diagnostics, int input, int output);
+
+} // namespace mull
@@ -44,3 +44,8 @@ void Bitcode::addMutation(MutationPoint *point) {
 std::map<llvm::Function *, std::vector<MutationPoint *>> &Bitcode::getMutationPointsMap() {
   return mutationPoints;
 }
+
+const std::map<llvm::Function *, std::vector<MutationPoint *>> &
+Bitcode::getMutationPointsMap() const {
+  return mutationPoints;
+}
@@ -0,0 +1,173 @@
+#include "mull/BitcodeExtractor.h"
+
+#include "LLVMCompatibility.h"
+#include "mull/Diagnostics/Diagnostics.h"
+
+#include <llvm/ADT/Triple.h>
+#include <llvm/Object/MachOUniversal.h>
+#include <llvm/Object/ObjectFile.h>
+
+using namespace mull;
+using namespace llvm;
+using namespace std::string_literals;
+
+static const StringRef BitcodeMagic("BC\xC0\xDE", 4);
+
+namespace {
+
+/// Reads the bitstream the same way as llvm::BitstreamCursor: little-endian words, LSB first
+class BitReader {
+public:
+  explicit BitReader(StringRef data) : data(data), position(0) {}
+
+  bool canRead(size_t bits) const {
+    return position + bits <= data.size() * 8;
+  }
+
+  uint64_t read(size_t bits) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < bits; i++, position++) {
+      uint8_t byte = data[position / 8];
+      value |= uint64_t((byte >> (position % 8)) & 1) << i;
+    }
+    return value;
+  }
+
+  bool readVBR(size_t bits, uint64_t &value) {
+    value = 0;
+    uint64_t continuation = 1ull << (bits - 1);
+    for (size_t shift = 0; shift < 64; shift += bits - 1) {
+      if (!canRead(bits)) {
+        return false;
+      }
+      uint64_t chunk = read(bits);
+      value |= (chunk & (continuation - 1)) << shift;
+      if ((chunk & continuation) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void alignTo32Bits() {
+    position = (position + 31) / 32 * 32;
+  }
+
+  void skip(size_t bits) {
+    position += bits;
+  }
+
+  size_t bytePosition() const {
+    return position / 8;
+  }
+
+private:
+  StringRef data;
+  size_t position;
+};
+
+} // namespace
+
+/// The size of the bitcode file at the beginning of 'data'. The top-level blocks (identification,
+/// module, string table, symbol table) are skipped using their length, the file ends where
+/// something else than a block starts, e.g. the next file or the alignment padding
+static size_t bitcodeFileSize(StringRef data) {
+  /// The abbreviation width of the top level is 2, ENTER_SUBBLOCK is 1
+  const size_t TopLevelAbbreviationWidth = 2;
+  const uint64_t EnterSubblock = 1;
+
+  BitReader reader(data);
+  reader.skip(BitcodeMagic.size() * 8);
+  size_t size = reader.bytePosition();
+  while (reader.canRead(TopLevelAbbreviationWidth) &&
+         reader.read(TopLevelAbbreviationWidth) == EnterSubblock) {
+    uint64_t blockId = 0;
+    uint64_t abbreviationWidth = 0;
+    if (!reader.readVBR(8, blockId) || !reader.readVBR(4, abbreviationWidth)) {
+      break;
+    }
+    reader.alignTo32Bits();
+    if (!reader.canRead(32)) {
+      break;
+    }
+    uint64_t lengthInWords = reader.read(32);
+    if (!reader.canRead(lengthInWords * 32)) {
+      break;
+    }
+    reader.skip(lengthInWords * 32);
+    size = reader.bytePosition();
+  }
+  return size;
+}
+
+static void splitBitcodeSection(StringRef content, std::vector<MemoryBufferRef> &bitcode) {
+  size_t offset = 0;
+  while (offset < content.size()) {
+    size_t start = content.find(BitcodeMagic, offset);
+    if (start == StringRef::npos) {
+      break;
+    }
+    size_t size = bitcodeFileSize(content.substr(start));
+    bitcode.emplace_back(content.substr(start, size), "");
+    offset = start + std::max<size_t>(size, 1);
+  }
+}
+
+static bool isBitcodeSection(StringRef name) {
+  return name == ".llvmbc" || name == "__bitcode";
+}
+
+static void extractFromObjectFile(object::ObjectFile &objectFile,
+                                  std::vector<MemoryBufferRef> &bitcode,
+                                  Diagnostics &diagnostics) {
+  size_t found = bitcode.size();
+  for (auto &section : objectFile.sections()) {
+    if (isBitcodeSection(llvm_compat::getSectionName(section))) {
+      splitBitcodeSection(llvm_compat::getSectionContent(section), bitcode);
+    }
+  }
+  /// The caller falls back to the bitcode bundles, it warns if there is none either
+  if (bitcode.size() == found) {
+    diagnostics.debug("No bitcode section: "s +
+                      Triple::getArchTypeName(objectFile.getArch()).str());
+  }
+}
+
+BitcodeExtractor::BitcodeExtractor(Diagnostics &diagnostics) : diagnostics(diagnostics) {}
+
+std::vector<MemoryBufferRef> BitcodeExtractor::extractBitcode(const std::string &executable) {
+  std::vector<MemoryBufferRef> bitcode;
+
+  /// Large files are memory mapped, the null terminator would force a copy
+  auto maybeBuffer = MemoryBuffer::getFile(executable, -1, false);
+  if (!maybeBuffer) {
+    diagnostics.warning("Cannot read executable: "s + maybeBuffer.getError().message());
+    return bitcode;
+  }
+  executableBuffer = std::move(maybeBuffer.get());
+
+  auto maybeBinary = object::createBinary(executableBuffer->getMemBufferRef());
+  if (!maybeBinary) {
+    diagnostics.warning("Cannot read executable: "s + toString(maybeBinary.takeError()));
+    return bitcode;
+  }
+  object::Binary *binary = maybeBinary->get();
+
+  if (auto objectFile = dyn_cast<object::ObjectFile>(binary)) {
+    extractFromObjectFile(*objectFile, bitcode, diagnostics);
+  } else if (auto universalBinary = dyn_cast<object::MachOUniversalBinary>(binary)) {
+    for (auto &slice : universalBinary->objects()) {
+      auto maybeObject = slice.getAsObjectFile();
+      if (!maybeObject) {
+        diagnostics.warning("Cannot read "s + slice.getArchFlagName() + " slice: " +
+                            toString(maybeObject.takeError()));
+        continue;
+      }
+      extractFromObjectFile(*maybeObject.get(), bitcode, diagnostics);
+    }
+  } else {
+    diagnostics.warning("Executable is not an object file: "s + executable);
+  }
+
+  return bitcode;
+}
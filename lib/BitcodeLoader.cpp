@@ -18,21 +18,39 @@
 using namespace llvm;
 using namespace mull;
 
+static void reportParsingError(MemoryBufferRef bufferRef, Error error, Diagnostics &diagnostics) {
+  std::stringstream errorMessage;
+  errorMessage << "parseBitcodeFile failed: \"" << toString(std::move(error)) << "\".";
+
+  auto producerString = getBitcodeProducerString(bufferRef);
+  if (producerString) {
+    errorMessage << " ";
+    errorMessage << "The bitcode file was created with LLVM version: " << producerString.get();
+  } else {
+    consumeError(producerString.takeError());
+  }
+
+  diagnostics.warning(errorMessage.str());
+}
+
 std::unique_ptr<Module> mull::parseBitcode(MemoryBufferRef bufferRef, LLVMContext &context,
                                            Diagnostics &diagnostics) {
   auto module = parseBitcodeFile(bufferRef, context);
   if (!module) {
-    std::stringstream errorMessage;
-    errorMessage << "parseBitcodeFile failed: \"" << toString(module.takeError()) << "\".";
-
-    auto producerString = getBitcodeProducerString(bufferRef);
-    if (producerString) {
-      errorMessage << " ";
-      errorMessage << "The bitcode file was created with LLVM version: " << producerString.get();
-    }
+    reportParsingError(bufferRef, module.takeError(), diagnostics);
+    return std::unique_ptr<Module>();
+  }
 
-    diagnostics.warning(errorMessage.str());
+  return std::move(module.get());
+}
 
+std::unique_ptr<Module> mull::loadLazyModuleFromBuffer(LLVMContext &context,
+                                                       std::unique_ptr<MemoryBuffer> buffer,
+                                                       Diagnostics &diagnostics) {
+  MemoryBufferRef bufferRef = buffer->getMemBufferRef();
+  auto module = getOwningLazyBitcodeModule(std::move(buffer), context);
+  if (!module) {
+    reportParsingError(bufferRef, module.takeError(), diagnostics);
     return std::unique_ptr<Module>();
   }
 
@@ -1,11 +1,29 @@
 #include "mull/BitcodeMetadataReader.h"
 
 #include "mull/Bitcode.h"
+#include "mull/Diagnostics/Diagnostics.h"
 #include "mull/Path.h"
 
+#include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/IR/DebugInfoMetadata.h>
+#include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 
+static void readCompilationFlags(llvm::Module *module,
+                                 std::map<std::string, std::string> &bitcodeCompilationFlags) {
+  for (llvm::DICompileUnit *unit : module->debug_compile_units()) {
+    llvm::StringRef directory = unit->getDirectory();
+    llvm::StringRef fileName = unit->getFilename();
+    std::string unitFullPath = mull::absoluteFilePath(directory.str(), fileName.str());
+
+    llvm::StringRef unitFlags = unit->getFlags();
+
+    if (!unitFlags.empty()) {
+      bitcodeCompilationFlags[unitFullPath] = unitFlags.str();
+    }
+  }
+}
+
 std::map<std::string, std::string> mull::BitcodeMetadataReader::getCompilationDatabase(
     std::vector<std::unique_ptr<mull::Bitcode>> &bitcode) {
   std::map<std::string, std::string> bitcodeCompilationFlags;
@@ -13,19 +31,22 @@ std::map<std::string, std::string> mull::BitcodeMetadataReader::getCompilationDa
     return bitcodeCompilationFlags;
   }
   for (auto &bitcodeModule: bitcode) {
-    llvm::Module *module = bitcodeModule->getModule();
-
-    for (llvm::DICompileUnit *unit : module->debug_compile_units()) {
-      llvm::StringRef directory = unit->getDirectory();
-      llvm::StringRef fileName = unit->getFilename();
-      std::string unitFullPath = absoluteFilePath(directory.str(), fileName.str());
-
-      llvm::StringRef unitFlags = unit->getFlags();
+    readCompilationFlags(bitcodeModule->getModule(), bitcodeCompilationFlags);
+  }
+  return bitcodeCompilationFlags;
+}
 
-      if (!unitFlags.empty()) {
-        bitcodeCompilationFlags[unitFullPath] = unitFlags.str();
-      }
+std::map<std::string, std::string> mull::BitcodeMetadataReader::getCompilationDatabase(
+    const std::vector<llvm::MemoryBufferRef> &bitcodeBuffers, Diagnostics &diagnostics) {
+  std::map<std::string, std::string> bitcodeCompilationFlags;
+  for (auto &buffer : bitcodeBuffers) {
+    llvm::LLVMContext context;
+    auto module = llvm::getLazyBitcodeModule(buffer, context);
+    if (!module) {
+      diagnostics.warning("Cannot read bitcode metadata: " + llvm::toString(module.takeError()));
+      continue;
     }
+    readCompilationFlags(module.get().get(), bitcodeCompilationFlags);
   }
   return bitcodeCompilationFlags;
 }
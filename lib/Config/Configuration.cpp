@@ -18,8 +18,11 @@ unsigned MullDefaultLinkerTimeoutMilliseconds = 30000;
 Configuration::Configuration()
     : debugEnabled(false), dryRunEnabled(false), captureTestOutput(true), captureMutantOutput(true),
       skipSanityCheckRun(false), includeNotCovered(false), keepObjectFiles(false),
-      keepExecutable(false), mutateOnly(false), timeout(MullDefaultTimeoutMilliseconds),
-      linkerTimeout(MullDefaultLinkerTimeoutMilliseconds), diagnostics(IDEDiagnosticsKind::None),
+      keepExecutable(false), mutateOnly(false), forkServer(false), mutantSchemata(false),
+      inProcessLinker(false), reachabilityProbes(false), detectEquivalentMutants(false),
+      timeout(MullDefaultTimeoutMilliseconds), linkerTimeout(MullDefaultLinkerTimeoutMilliseconds),
+      memoryBudget(0), shardIndex(0), shardCount(0), diagnostics(IDEDiagnosticsKind::None),
+      codegenProfile(CodegenProfile::Default), testFramework(TestFrameworkKind::None),
       parallelization(singleThreadParallelization()) {}
 
 } // namespace mull
@@ -11,6 +11,32 @@
 
 namespace mull {
 
+static const std::pair<CodegenProfile, const char *> CodegenProfileNames[] = {
+  { CodegenProfile::Default, "default" },
+  { CodegenProfile::FastCompile, "fast-compile" },
+  { CodegenProfile::FastRun, "fast-run" },
+  { CodegenProfile::Auto, "auto" },
+};
+
+std::string codegenProfileName(CodegenProfile profile) {
+  for (auto &pair : CodegenProfileNames) {
+    if (pair.first == profile) {
+      return pair.second;
+    }
+  }
+  return "default";
+}
+
+bool parseCodegenProfile(const std::string &name, CodegenProfile &profile) {
+  for (auto &pair : CodegenProfileNames) {
+    if (name == pair.second) {
+      profile = pair.first;
+      return true;
+    }
+  }
+  return false;
+}
+
 ParallelizationConfig::ParallelizationConfig()
     : workers(0), testExecutionWorkers(0), mutantExecutionWorkers(0) {}
 
@@ -9,16 +9,24 @@
 #include "mull/MutantRunner.h"
 #include "mull/MutationResult.h"
 #include "mull/MutationsFinder.h"
+#include "mull/Path.h"
 #include "mull/Parallelization/Parallelization.h"
 #include "mull/Program/Program.h"
 #include "mull/Result.h"
+#include "mull/ResultCache.h"
+#include "mull/Runtime/ForkServerRuntime.h"
+#include "mull/Runtime/ReachabilityRuntime.h"
+#include "mull/Runtime/TestCoverageRuntime.h"
+#include "mull/Sharding.h"
 #include "mull/Toolchain/Runner.h"
 
+#include <llvm/IR/DebugInfoMetadata.h>
 #include <llvm/ProfileData/Coverage/CoverageMapping.h>
 #include <llvm/Support/DynamicLibrary.h>
 #include <llvm/Support/Path.h>
 
 #include <algorithm>
+#include <iterator>
 #include <sstream>
 #include <unordered_map>
 #include <unordered_set>
@@ -33,49 +41,165 @@ Driver::~Driver() {
   delete this->ideDiagnostics;
 }
 
+/// The same mutant may come from several modules (e.g. an inline function from a header).
+/// Consider a mutant covered if at least one of the mutation points is covered
+static void collectMutants(const std::vector<MutationPoint *> &mutationPoints,
+                           std::unordered_map<std::string, std::unique_ptr<Mutant>> &mapping) {
+  for (MutationPoint *point : mutationPoints) {
+    std::unique_ptr<Mutant> &mutant = mapping[point->getUserIdentifier()];
+    if (mutant && (mutant->isCovered() || !point->isCovered())) {
+      continue;
+    }
+    mutant = std::make_unique<Mutant>(point->getUserIdentifier(),
+                                      point->getMutatorIdentifier(),
+                                      point->getSourceLocation(),
+                                      point->getEndLocation(),
+                                      point->isCovered());
+    mutant->setMutatorKind(point->getMutator()->mutatorKind());
+  }
+}
+
+static std::vector<std::unique_ptr<Mutant>>
+sortMutants(std::unordered_map<std::string, std::unique_ptr<Mutant>> &mapping) {
+  std::vector<std::unique_ptr<Mutant>> mutants;
+  for (auto &pair : mapping) {
+    mutants.push_back(std::move(pair.second));
+  }
+  std::sort(std::begin(mutants), std::end(mutants), MutantComparator());
+  return mutants;
+}
+
+static void removeObjectFiles(const std::vector<std::string> &objectFiles) {
+  for (auto &objectFile : objectFiles) {
+    llvm::sys::fs::remove(objectFile);
+  }
+}
+
+/// A loaded module together with its context and the mutated functions takes roughly
+/// this many times more memory than its bitcode
+static const size_t ModuleMemoryFactor = 10;
+
+static std::vector<std::vector<llvm::MemoryBufferRef>>
+splitIntoBatches(const std::vector<llvm::MemoryBufferRef> &bitcodeBuffers, unsigned memoryBudget) {
+  size_t budget = size_t(memoryBudget) * 1024 * 1024;
+  std::vector<std::vector<llvm::MemoryBufferRef>> batches(1);
+  size_t batchSize = 0;
+  for (auto &buffer : bitcodeBuffers) {
+    size_t moduleSize = buffer.getBufferSize() * ModuleMemoryFactor;
+    if (!batches.back().empty() && batchSize + moduleSize > budget) {
+      batches.emplace_back();
+      batchSize = 0;
+    }
+    batches.back().push_back(buffer);
+    batchSize += moduleSize;
+  }
+  return batches;
+}
+
 std::unique_ptr<Result> Driver::run() {
+  if (program.isStreaming()) {
+    return streamingRun();
+  }
+
+  runSanityCheck();
   auto mutationPoints = findMutationPoints();
   auto filteredMutations = filterMutations(std::move(mutationPoints));
+  hashProgram(filteredMutations);
+  estimateMutantCosts(filteredMutations);
   prepareMutations(filteredMutations);
+  prepareForkServer();
   std::vector<std::unique_ptr<Mutant>> mutants;
   singleTask.execute("Deduplicate mutants", [&]() {
-    std::unordered_map<std::string, std::vector<MutationPoint *>> mapping;
-    for (MutationPoint *point : filteredMutations) {
-      mapping[point->getUserIdentifier()].push_back(point);
+    std::unordered_map<std::string, std::unique_ptr<Mutant>> mapping;
+    collectMutants(filteredMutations, mapping);
+    mutants = sortMutants(mapping);
+  });
+  dropEquivalentMutants(mutants);
+  keepShard(mutants);
+
+  auto mutationResults = reuseCachedResults(
+      mutants, [&](std::vector<std::unique_ptr<Mutant>> &mutantsToRun) {
+        return runMutations(mutantsToRun);
+      });
+
+  return std::make_unique<Result>(std::move(mutants), std::move(mutationResults));
+}
+
+const MutantSet &Driver::getShardedMutants() const {
+  return shardedMutants;
+}
+
+std::unique_ptr<Result> Driver::streamingRun() {
+  runSanityCheck();
+
+  auto batches = splitIntoBatches(program.bitcodeBuffers(), config.memoryBudget);
+  std::unordered_map<std::string, std::unique_ptr<Mutant>> mapping;
+  std::vector<std::string> objectFiles;
+  for (size_t i = 0; i < batches.size(); i++) {
+    std::stringstream message;
+    message << "Processing batch " << i + 1 << "/" << batches.size() << " (" << batches[i].size()
+            << " modules)";
+    diagnostics.info(message.str());
+
+    loadBitcode(batches[i]);
+    auto mutationPoints = findMutationPoints();
+    auto filteredMutations = filterMutations(std::move(mutationPoints));
+    hashProgram(filteredMutations);
+    estimateMutantCosts(filteredMutations);
+    prepareMutations(filteredMutations);
+    if (i + 1 == batches.size()) {
+      prepareForkServer();
     }
-    for (auto &pair : mapping) {
-      std::string identifier = pair.first;
-      MutationPoint *anyPoint = pair.second.front();
-      std::string mutatorIdentifier = anyPoint->getMutatorIdentifier();
-      const SourceLocation &sourceLocation = anyPoint->getSourceLocation();
-      const SourceLocation &endLocation = anyPoint->getEndLocation();
-      bool covered = false;
-      for (MutationPoint *point : pair.second) {
-        /// Consider a mutant covered if at least one of the mutation points is covered
-        if (point->isCovered()) {
-          covered = true;
-          break;
-        }
-      }
+    singleTask.execute("Deduplicate mutants",
+                       [&]() { collectMutants(filteredMutations, mapping); });
 
-      mutants.push_back(std::make_unique<Mutant>(
-          identifier, mutatorIdentifier, sourceLocation, endLocation, covered));
-      mutants.back()->setMutatorKind(anyPoint->getMutator()->mutatorKind());
+    if (!config.dryRunEnabled) {
+      std::vector<std::string> batchObjectFiles = compileProgram(filteredMutations.size());
+      std::move(batchObjectFiles.begin(), batchObjectFiles.end(), std::back_inserter(objectFiles));
     }
-    std::sort(std::begin(mutants), std::end(mutants), MutantComparator());
-  });
 
-  auto mutationResults = runMutations(mutants);
+    /// The mutation points refer to the modules, so both are released before the next batch
+    mutationsFinder.releaseMutationPoints();
+    program.bitcode().clear();
+  }
+
+  std::vector<std::unique_ptr<Mutant>> mutants = sortMutants(mapping);
+  dropEquivalentMutants(mutants);
+  keepShard(mutants);
+  auto mutationResults = reuseCachedResults(
+      mutants, [&](std::vector<std::unique_ptr<Mutant>> &mutantsToRun) {
+        if (mutantsToRun.empty() || config.dryRunEnabled) {
+          if (!config.keepObjectFiles) {
+            removeObjectFiles(objectFiles);
+          }
+          return runMutations(mutantsToRun);
+        }
+        return linkAndRunMutants(objectFiles, mutantsToRun);
+      });
 
   return std::make_unique<Result>(std::move(mutants), std::move(mutationResults));
 }
 
-std::vector<MutationPoint *> Driver::findMutationPoints() {
+void Driver::loadBitcode(std::vector<llvm::MemoryBufferRef> &bitcodeBuffers) {
+  std::vector<LoadBitcodeFromBinaryTask> tasks;
+  tasks.reserve(config.parallelization.workers);
+  for (int i = 0; i < config.parallelization.workers; i++) {
+    tasks.emplace_back(diagnostics);
+  }
+  std::vector<std::unique_ptr<Bitcode>> bitcode;
+  TaskExecutor<LoadBitcodeFromBinaryTask> loader(
+      diagnostics, "Loading bitcode files", bitcodeBuffers, bitcode, std::move(tasks));
+  loader.execute(&threadPool);
+  program.bitcode() = std::move(bitcode);
+}
+
+void Driver::runSanityCheck() {
   if (!config.skipSanityCheckRun) {
     Runner runner(diagnostics);
     singleTask.execute("Sanity check run", [&]() {
       ExecutionResult result = runner.runProgram(
           config.executable, {}, {}, config.timeout, config.captureTestOutput, std::nullopt);
+      originalRunningTime = result.runningTime;
       if (result.status != Passed) {
         std::stringstream failureMessage;
         failureMessage << "Original test failed\n";
@@ -92,14 +216,17 @@ std::vector<MutationPoint *> Driver::findMutationPoints() {
       }
     });
   }
+}
 
+std::vector<MutationPoint *> Driver::findMutationPoints() {
   std::vector<FunctionUnderTest> functionsUnderTest = getFunctionsUnderTest();
+  materializeFunctions(functionsUnderTest);
   std::vector<FunctionUnderTest> filteredFunctions = filterFunctions(functionsUnderTest);
 
   selectInstructions(filteredFunctions);
 
   std::vector<MutationPoint *> mutationPoints =
-      mutationsFinder.getMutationPoints(diagnostics, program, filteredFunctions);
+      mutationsFinder.getMutationPoints(diagnostics, program, filteredFunctions, &threadPool);
 
   return mutationPoints;
 }
@@ -118,8 +245,9 @@ std::vector<MutationPoint *> Driver::filterMutations(std::vector<MutationPoint *
     std::vector<MutationPoint *> tmp;
     TaskExecutor<MutationFilterTask> filterRunner(
         diagnostics, label, mutations, tmp, std::move(tasks));
-    filterRunner.execute();
+    filterRunner.execute(&threadPool);
     mutations = std::move(tmp);
+    filter->reportStatistics(diagnostics);
   }
 
   return mutations;
@@ -139,13 +267,31 @@ std::vector<FunctionUnderTest> Driver::filterFunctions(std::vector<FunctionUnder
     std::vector<FunctionUnderTest> tmp;
     TaskExecutor<FunctionFilterTask> filterRunner(
         diagnostics, label, filteredFunctions, tmp, std::move(tasks));
-    filterRunner.execute();
+    filterRunner.execute(&threadPool);
     filteredFunctions = std::move(tmp);
   }
 
   return filteredFunctions;
 }
 
+void Driver::materializeFunctions(const std::vector<FunctionUnderTest> &functions) {
+  std::unordered_set<llvm::Function *> materializedFunctions;
+  for (auto &function : functions) {
+    materializedFunctions.insert(function.getFunction());
+  }
+
+  std::vector<MaterializeFunctionsTask> tasks;
+  tasks.reserve(config.parallelization.workers);
+  for (int i = 0; i < config.parallelization.workers; i++) {
+    tasks.emplace_back(diagnostics, &materializedFunctions);
+  }
+
+  std::vector<int> Nothing;
+  TaskExecutor<MaterializeFunctionsTask> materializer(
+      diagnostics, "Materializing functions", program.bitcode(), Nothing, std::move(tasks));
+  materializer.execute(&threadPool);
+}
+
 void Driver::selectInstructions(std::vector<FunctionUnderTest> &functions) {
   std::vector<InstructionSelectionTask> tasks;
   tasks.reserve(config.parallelization.workers);
@@ -156,7 +302,7 @@ void Driver::selectInstructions(std::vector<FunctionUnderTest> &functions) {
   std::vector<int> Nothing;
   TaskExecutor<InstructionSelectionTask> filterRunner(
       diagnostics, "Instruction selection", functions, Nothing, std::move(tasks));
-  filterRunner.execute();
+  filterRunner.execute(&threadPool);
 }
 
 std::vector<std::unique_ptr<MutationResult>>
@@ -187,7 +333,7 @@ Driver::dryRunMutations(std::vector<std::unique_ptr<Mutant>> &mutants) {
   }
   TaskExecutor<DryRunMutantExecutionTask> mutantRunner(
       diagnostics, "Running mutants (dry run)", mutants, mutationResults, std::move(tasks));
-  mutantRunner.execute();
+  mutantRunner.execute(&threadPool);
 
   return mutationResults;
 }
@@ -204,13 +350,17 @@ void Driver::prepareMutations(std::vector<MutationPoint *> mutationPoints) {
 
   auto workers = config.parallelization.workers;
   std::vector<int> devNull;
-  TaskExecutor<CloneMutatedFunctionsTask> cloneFunctions(
-      diagnostics,
-      "Cloning functions for mutation",
-      program.bitcode(),
-      devNull,
-      std::vector<CloneMutatedFunctionsTask>(workers));
-  cloneFunctions.execute();
+  std::vector<CloneMutatedFunctionsTask> cloneTasks;
+  cloneTasks.reserve(workers);
+  for (int i = 0; i < workers; i++) {
+    cloneTasks.emplace_back(config.mutantSchemata);
+  }
+  TaskExecutor<CloneMutatedFunctionsTask> cloneFunctions(diagnostics,
+                                                         "Cloning functions for mutation",
+                                                         program.bitcode(),
+                                                         devNull,
+                                                         std::move(cloneTasks));
+  cloneFunctions.execute(&threadPool);
 
   std::vector<int> Nothing;
   TaskExecutor<DeleteOriginalFunctionsTask> deleteOriginalFunctions(
@@ -219,7 +369,7 @@ void Driver::prepareMutations(std::vector<MutationPoint *> mutationPoints) {
       program.bitcode(),
       Nothing,
       std::vector<DeleteOriginalFunctionsTask>(workers));
-  deleteOriginalFunctions.execute();
+  deleteOriginalFunctions.execute(&threadPool);
 
   TaskExecutor<InsertMutationTrampolinesTask> redirectFunctions(
       diagnostics,
@@ -227,16 +377,305 @@ void Driver::prepareMutations(std::vector<MutationPoint *> mutationPoints) {
       program.bitcode(),
       Nothing,
       std::vector<InsertMutationTrampolinesTask>(workers));
-  redirectFunctions.execute();
+  redirectFunctions.execute(&threadPool);
+
+  if (config.testFramework != TestFrameworkKind::None) {
+    singleTask.execute("Inserting test coverage probes", [&]() {
+      for (auto &bitcode : program.bitcode()) {
+        std::map<llvm::Function *, std::vector<std::string>> mutants;
+        for (auto &pair : bitcode->getMutationPointsMap()) {
+          for (MutationPoint *point : pair.second) {
+            if (point->isCovered()) {
+              mutants[pair.first].push_back(point->getUserIdentifier());
+            }
+          }
+        }
+        insertTestCoverage(*bitcode->getModule(), mutants);
+      }
+    });
+  }
 
   TaskExecutor<ApplyMutationTask> applyMutations(
       diagnostics, "Applying mutations", mutationPoints, Nothing, { ApplyMutationTask() });
-  applyMutations.execute();
+  applyMutations.execute(&threadPool);
+
+  if (config.detectEquivalentMutants) {
+    detectEquivalentMutants(mutationPoints);
+  }
+
+  if (config.reachabilityProbes) {
+    insertReachabilityProbes();
+  }
+}
+
+void Driver::detectEquivalentMutants(const std::vector<MutationPoint *> &mutationPoints) {
+  std::vector<MutationPointFingerprint> fingerprints;
+  TaskExecutor<EquivalentMutantsTask> detector(
+      diagnostics,
+      "Detecting equivalent mutants",
+      program.bitcode(),
+      fingerprints,
+      std::vector<EquivalentMutantsTask>(config.parallelization.workers));
+  detector.execute(&threadPool);
+
+  singleTask.execute("Grouping equivalent mutants", [&]() {
+    std::unordered_map<MutationPoint *, const MutationPointFingerprint *> pointFingerprints;
+    for (auto &fingerprint : fingerprints) {
+      pointFingerprints[fingerprint.point] = &fingerprint;
+    }
+    for (MutationPoint *point : mutationPoints) {
+      if (!point->isCovered()) {
+        continue;
+      }
+      std::string identifier = point->getUserIdentifier();
+      auto fingerprint = pointFingerprints.find(point);
+      if (fingerprint == pointFingerprints.end()) {
+        /// E.g. a schemata mutant: it is neither equivalent nor a duplicate of anything
+        nonEquivalentMutants.insert(identifier);
+        mutantFingerprints[identifier].push_back(identifier);
+        continue;
+      }
+      if (fingerprint->second->equivalent) {
+        equivalentMutants.insert(identifier);
+      } else {
+        nonEquivalentMutants.insert(identifier);
+      }
+      mutantFingerprints[identifier].push_back(fingerprint->second->fingerprint);
+    }
+  });
+}
+
+void Driver::dropEquivalentMutants(std::vector<std::unique_ptr<Mutant>> &mutants) {
+  if (!config.detectEquivalentMutants || config.dryRunEnabled) {
+    return;
+  }
+  size_t equivalentCount = 0;
+  singleTask.execute("Dropping equivalent mutants", [&]() {
+    std::vector<std::unique_ptr<Mutant>> keptMutants;
+    /// The mutants are sorted, so the first one of each group runs regardless of the batches
+    std::unordered_map<std::string, std::string> representatives;
+    for (auto &mutant : mutants) {
+      const std::string &identifier = mutant->getIdentifier();
+      if (equivalentMutants.count(identifier) && !nonEquivalentMutants.count(identifier)) {
+        equivalentCount++;
+        continue;
+      }
+      auto fingerprints = mutantFingerprints.find(identifier);
+      if (fingerprints != mutantFingerprints.end()) {
+        std::vector<std::string> parts(fingerprints->second);
+        std::sort(parts.begin(), parts.end());
+        std::string signature;
+        for (auto &part : parts) {
+          signature += part + "\n";
+        }
+        auto representative = representatives.emplace(signature, identifier);
+        if (!representative.second) {
+          duplicateMutants[identifier] = representative.first->second;
+        }
+      }
+      keptMutants.push_back(std::move(mutant));
+    }
+    mutants = std::move(keptMutants);
+  });
+
+  std::stringstream message;
+  message << "Dropped " << equivalentCount << " equivalent mutants, " << duplicateMutants.size()
+          << " mutants share the result of a duplicate";
+  diagnostics.info(message.str());
+}
+
+void Driver::insertReachabilityProbes() {
+  singleTask.execute("Inserting reachability probes", [&]() {
+    for (auto &bitcode : program.bitcode()) {
+      llvm::Module *module = bitcode->getModule();
+      /// The addresses are instruction indices: all of them are resolved before the first probe
+      std::vector<std::pair<llvm::Instruction *, size_t>> probes;
+      for (auto &pair : bitcode->getMutationPointsMap()) {
+        for (MutationPoint *point : pair.second) {
+          if (!point->isCovered()) {
+            continue;
+          }
+          llvm::Function *originalCopy = module->getFunction(point->getOriginalFunctionName());
+          assert(originalCopy && "The original function should be present");
+          probes.emplace_back(&point->getAddress().findInstruction(originalCopy),
+                              reachabilitySlots.add(point->getUserIdentifier()));
+        }
+      }
+      mull::insertReachabilityProbes(*module, probes);
+    }
+  });
+}
+
+void Driver::materializeAllFunctions() {
+  std::vector<MaterializeFunctionsTask> materializationTasks;
+  materializationTasks.reserve(config.parallelization.workers);
+  for (int i = 0; i < config.parallelization.workers; i++) {
+    materializationTasks.emplace_back(diagnostics, nullptr);
+  }
+  std::vector<int> Nothing;
+  TaskExecutor<MaterializeFunctionsTask> materializer(diagnostics,
+                                                      "Materializing remaining functions",
+                                                      program.bitcode(),
+                                                      Nothing,
+                                                      std::move(materializationTasks));
+  materializer.execute(&threadPool);
+}
+
+void Driver::hashProgram(const std::vector<MutationPoint *> &mutationPoints) {
+  if (!resultCache) {
+    return;
+  }
+  /// The rest of the program is a part of the cache key, so all of it must be parsed
+  materializeAllFunctions();
+  singleTask.execute("Hashing program",
+                     [&]() { resultCache->hashProgram(program.bitcode(), mutationPoints); });
+}
+
+std::vector<std::unique_ptr<MutationResult>> Driver::reuseCachedResults(
+    std::vector<std::unique_ptr<Mutant>> &mutants,
+    const std::function<std::vector<std::unique_ptr<MutationResult>>(
+        std::vector<std::unique_ptr<Mutant>> &)> &runMutants) {
+  if (!resultCache) {
+    return runMutants(mutants);
+  }
+
+  std::vector<std::unique_ptr<MutationResult>> cachedResults;
+  std::vector<std::unique_ptr<Mutant>> cachedMutants;
+  std::vector<std::unique_ptr<Mutant>> mutantsToRun;
+  singleTask.execute("Looking up cached results", [&]() {
+    for (auto &mutant : mutants) {
+      ExecutionResult result;
+      if (mutant->isCovered() && resultCache->lookup(*mutant, result)) {
+        cachedResults.push_back(std::make_unique<MutationResult>(result, mutant.get()));
+        cachedMutants.push_back(std::move(mutant));
+      } else {
+        mutantsToRun.push_back(std::move(mutant));
+      }
+    }
+  });
+  std::stringstream message;
+  message << "Reusing " << cachedResults.size() << " cached results, " << mutantsToRun.size()
+          << " mutants to run";
+  diagnostics.info(message.str());
+
+  std::vector<std::unique_ptr<MutationResult>> mutationResults = runMutants(mutantsToRun);
+
+  singleTask.execute("Updating result cache", [&]() {
+    for (auto &mutationResult : mutationResults) {
+      resultCache->store(*mutationResult->getMutant(), mutationResult->getExecutionResult());
+    }
+    resultCache->save();
+  });
+
+  /// The mutants are owned by the caller, the results only point to them
+  mutants.clear();
+  std::move(mutantsToRun.begin(), mutantsToRun.end(), std::back_inserter(mutants));
+  std::move(cachedMutants.begin(), cachedMutants.end(), std::back_inserter(mutants));
+  std::sort(std::begin(mutants), std::end(mutants), MutantComparator());
+  std::move(cachedResults.begin(), cachedResults.end(), std::back_inserter(mutationResults));
+  return mutationResults;
+}
+
+void Driver::estimateMutantCosts(const std::vector<MutationPoint *> &mutationPoints) {
+  if (config.shardCount <= 1) {
+    return;
+  }
+  /// The timings are measured on each machine and differ between them, while the code is the
+  /// same everywhere. A mutant of a bigger function is assumed to take longer to run.
+  singleTask.execute("Estimating mutant costs", [&]() {
+    std::unordered_map<llvm::Function *, long long> functionSizes;
+    for (MutationPoint *point : mutationPoints) {
+      llvm::Function *function = point->getOriginalFunction();
+      auto size = functionSizes.find(function);
+      if (size == functionSizes.end()) {
+        long long instructions = 0;
+        for (auto &basicBlock : *function) {
+          instructions += basicBlock.size();
+        }
+        size = functionSizes.emplace(function, instructions).first;
+      }
+      long long &cost = mutantCosts[point->getUserIdentifier()];
+      cost = std::max(cost, size->second);
+    }
+  });
+}
+
+void Driver::keepShard(std::vector<std::unique_ptr<Mutant>> &mutants) {
+  if (config.shardCount <= 1) {
+    return;
+  }
+  /// Not covered mutants do not run
+  auto cost = [&](const Mutant &mutant) {
+    if (!mutant.isCovered()) {
+      return 0LL;
+    }
+    auto estimate = mutantCosts.find(mutant.getIdentifier());
+    return estimate == mutantCosts.end() ? 1LL : std::max(estimate->second, 1LL);
+  };
+  size_t total = mutants.size();
+  singleTask.execute("Selecting shard", [&]() {
+    shardedMutants = describeMutants(mutants);
+    mutants = selectShard(std::move(mutants), cost, config.shardIndex, config.shardCount);
+  });
+  std::stringstream message;
+  message << "Shard " << config.shardIndex << "/" << config.shardCount << ": " << mutants.size()
+          << " of " << total << " mutants";
+  diagnostics.info(message.str());
+}
+
+void Driver::prepareForkServer() {
+  if (config.forkServer && !config.dryRunEnabled && !program.bitcode().empty()) {
+    /// The last module is linked last, so its constructor runs after the other initializers
+    singleTask.execute("Inserting fork server",
+                       [&]() { insertForkServer(*program.bitcode().back()->getModule()); });
+  }
+}
+
+CodegenProfile Driver::selectCodegenProfile(size_t mutantsCount) {
+  /// Rough estimates: the codegen handles ~50 instructions per millisecond,
+  /// and a mutant runs about as long as the original program
+  size_t instructionsCount = 0;
+  for (auto &bitcode : program.bitcode()) {
+    for (auto &function : *bitcode->getModule()) {
+      for (auto &basicBlock : function) {
+        instructionsCount += basicBlock.size();
+      }
+    }
+  }
+  CodegenEstimate estimate{ (long long)instructionsCount / 50 / config.parallelization.workers,
+                            -1 };
+  /// The sanity check run is skipped, e.g. with -mutate-only, so the mutants' time is unknown
+  if (!config.mutateOnly && originalRunningTime != 0) {
+    estimate.executionTime = originalRunningTime * (long long)mutantsCount /
+                             config.parallelization.mutantExecutionWorkers;
+  }
+
+  CodegenProfile profile = mull::selectCodegenProfile(estimate);
+  std::stringstream message;
+  message << "Using " << codegenProfileName(profile)
+          << " codegen profile (estimated compilation: " << estimate.compilationTime << "ms, ";
+  if (estimate.executionTime < 0) {
+    message << "execution estimate unavailable: the sanity check run is skipped)";
+  } else {
+    message << "estimated execution: " << estimate.executionTime << "ms)";
+  }
+  diagnostics.info(message.str());
+  return profile;
 }
 
 std::vector<std::unique_ptr<MutationResult>>
 Driver::normalRunMutations(std::vector<std::unique_ptr<Mutant>> &mutants) {
+  std::vector<std::string> objectFiles = compileProgram(mutants.size());
+  return linkAndRunMutants(objectFiles, mutants);
+}
+
+std::vector<std::string> Driver::compileProgram(size_t mutantsCount) {
   auto workers = config.parallelization.workers;
+  materializeAllFunctions();
+
+  if (config.codegenProfile == CodegenProfile::Auto) {
+    toolchain.compiler().setCodegenProfile(selectCodegenProfile(mutantsCount));
+  }
 
   std::vector<OriginalCompilationTask> compilationTasks;
   compilationTasks.reserve(workers);
@@ -248,27 +687,78 @@ Driver::normalRunMutations(std::vector<std::unique_ptr<Mutant>> &mutants) {
                                                        "Compiling original code",
                                                        program.bitcode(),
                                                        objectFiles,
-                                                       std::move(compilationTasks));
-  mutantCompiler.execute();
+                                                       std::move(compilationTasks),
+                                                       TaskScheduling::Dynamic);
+  mutantCompiler.execute(&threadPool);
+
+  return objectFiles;
+}
 
+/// A duplicate runs on its own only if its representative is elsewhere (another shard or the cache)
+std::vector<std::unique_ptr<MutationResult>>
+Driver::runDistinctMutants(MutantRunner &mutantRunner, const std::string &executable,
+                           std::vector<std::unique_ptr<Mutant>> &mutants) {
+  std::unordered_set<std::string> present;
+  for (auto &mutant : mutants) {
+    present.insert(mutant->getIdentifier());
+  }
+  std::vector<std::unique_ptr<Mutant>> distinctMutants;
+  std::vector<std::unique_ptr<Mutant>> duplicates;
+  for (auto &mutant : mutants) {
+    auto duplicate = duplicateMutants.find(mutant->getIdentifier());
+    if (duplicate != duplicateMutants.end() && present.count(duplicate->second)) {
+      duplicates.push_back(std::move(mutant));
+    } else {
+      distinctMutants.push_back(std::move(mutant));
+    }
+  }
+
+  std::vector<std::unique_ptr<MutationResult>> mutationResults =
+      mutantRunner.runMutants(executable, distinctMutants);
+
+  std::unordered_map<std::string, const ExecutionResult *> results;
+  for (auto &mutationResult : mutationResults) {
+    results[mutationResult->getMutant()->getIdentifier()] = &mutationResult->getExecutionResult();
+  }
+  std::vector<std::unique_ptr<MutationResult>> duplicateResults;
+  for (auto &duplicate : duplicates) {
+    const ExecutionResult &result = *results.at(duplicateMutants.at(duplicate->getIdentifier()));
+    duplicateResults.push_back(std::make_unique<MutationResult>(result, duplicate.get()));
+  }
+
+  /// The mutants are owned by the caller, the results only point to them
+  mutants.clear();
+  std::move(distinctMutants.begin(), distinctMutants.end(), std::back_inserter(mutants));
+  std::move(duplicates.begin(), duplicates.end(), std::back_inserter(mutants));
+  std::sort(std::begin(mutants), std::end(mutants), MutantComparator());
+  std::move(duplicateResults.begin(), duplicateResults.end(), std::back_inserter(mutationResults));
+  return mutationResults;
+}
+
+std::vector<std::unique_ptr<MutationResult>>
+Driver::linkAndRunMutants(std::vector<std::string> &objectFiles,
+                          std::vector<std::unique_ptr<Mutant>> &mutants) {
   std::string executable;
   singleTask.execute("Link mutated program",
                      [&]() { executable = toolchain.linker().linkObjectFiles(objectFiles); });
 
   diagnostics.info("Mutated executable: "s + executable);
   if (!config.keepObjectFiles) {
-    for (auto &objectFile : objectFiles) {
-      llvm::sys::fs::remove(objectFile);
-    }
+    removeObjectFiles(objectFiles);
   }
 
   if (config.mutateOnly) {
     return std::vector<std::unique_ptr<MutationResult>>();
   }
 
-  MutantRunner mutantRunner(diagnostics, config);
-  std::vector<std::unique_ptr<MutationResult>> mutationResults =
-      mutantRunner.runMutants(executable, mutants);
+  MutantRunner mutantRunner(
+      diagnostics, config, &threadPool, config.reachabilityProbes ? &reachabilitySlots : nullptr);
+  std::vector<std::unique_ptr<MutationResult>> mutationResults;
+  if (duplicateMutants.empty()) {
+    mutationResults = mutantRunner.runMutants(executable, mutants);
+  } else {
+    mutationResults = runDistinctMutants(mutantRunner, executable, mutants);
+  }
 
   if (!config.keepExecutable) {
     llvm::sys::fs::remove(executable);
@@ -280,7 +770,15 @@ Driver::normalRunMutations(std::vector<std::unique_ptr<Mutant>> &mutants) {
 Driver::Driver(Diagnostics &diagnostics, const Configuration &config, Program &program,
                Toolchain &t, Filters &filters, MutationsFinder &mutationsFinder)
     : config(config), program(program), toolchain(t), mutationsFinder(mutationsFinder),
-      diagnostics(diagnostics), filters(filters), singleTask(diagnostics) {
+      diagnostics(diagnostics), filters(filters), singleTask(diagnostics),
+      threadPool(std::max(config.parallelization.workers,
+                          config.parallelization.mutantExecutionWorkers)),
+      originalRunningTime(0), coverageLoaded(false) {
+
+  if (!config.resultCache.empty() && !config.dryRunEnabled) {
+    resultCache = std::make_unique<ResultCache>(diagnostics, config.resultCache);
+    singleTask.execute("Loading result cache", [&]() { resultCache->load(); });
+  }
 
   if (config.diagnostics != IDEDiagnosticsKind::None) {
     this->ideDiagnostics = new NormalIDEDiagnostics(config.diagnostics);
@@ -307,11 +805,29 @@ loadCoverage(const Configuration &configuration, Diagnostics &diagnostics) {
   return std::move(maybeMapping.get());
 }
 
+/// Lazily loaded functions have no debug info until materialized, but the compile unit is known
+/// upfront: each embedded bitcode module is a single translation unit
+static std::string unitFilePath(llvm::Function &function) {
+  if (!function.isMaterializable()) {
+    return SourceLocation::locationFromFunction(&function).unitFilePath;
+  }
+  auto units = function.getParent()->debug_compile_units();
+  if (units.begin() == units.end()) {
+    return std::string();
+  }
+  llvm::DICompileUnit *unit = *units.begin();
+  return absoluteFilePath(unit->getDirectory().str(), unit->getFilename().str());
+}
+
 std::vector<FunctionUnderTest> Driver::getFunctionsUnderTest() {
   std::vector<FunctionUnderTest> functionsUnderTest;
 
   singleTask.execute("Gathering functions under test", [&]() {
-    std::unique_ptr<llvm::coverage::CoverageMapping> coverage = loadCoverage(config, diagnostics);
+    /// In streaming mode the functions are gathered once per batch
+    if (!coverageLoaded) {
+      coverage = loadCoverage(config, diagnostics);
+      coverageLoaded = true;
+    }
     if (coverage) {
       /// Some of the function records contain just name, the others are prefixed with the filename
       /// to avoid collisions
@@ -343,7 +859,7 @@ std::vector<FunctionUnderTest> Driver::getFunctionsUnderTest() {
           if (unscopedFunctions.count(name)) {
             covered = true;
           } else {
-            std::string filepath = SourceLocation::locationFromFunction(&function).unitFilePath;
+            std::string filepath = unitFilePath(function);
             std::string scope = llvm::sys::path::filename(filepath).str();
             if (scopedFunctions[scope].count(name)) {
               covered = true;
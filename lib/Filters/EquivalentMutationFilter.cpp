@@ -0,0 +1,196 @@
+#include "mull/Filters/EquivalentMutationFilter.h"
+
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/MutationPoint.h"
+#include "mull/Mutators/Mutator.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/InstrTypes.h>
+#include <llvm/IR/Instructions.h>
+#include <sstream>
+
+using namespace mull;
+
+static bool isConstantInt(llvm::Value *value, uint64_t expected) {
+  auto constant = llvm::dyn_cast<llvm::ConstantInt>(value);
+  return constant && constant->getValue() == expected;
+}
+
+static bool isConstantFloatOne(llvm::Value *value) {
+  auto constant = llvm::dyn_cast<llvm::ConstantFP>(value);
+  return constant && constant->isExactlyValue(1.0);
+}
+
+/// x + 0 and x - 0, the sign of a floating-point zero matters, so only integers qualify
+static bool addsZero(MutatorKind kind, llvm::Instruction &instruction) {
+  switch (kind) {
+  case MutatorKind::CXX_AddToSub:
+  case MutatorKind::CXX_AddAssignToSubAssign:
+  case MutatorKind::CXX_PreIncToPreDec:
+  case MutatorKind::CXX_PostIncToPostDec:
+    return instruction.getOpcode() == llvm::Instruction::Add &&
+           isConstantInt(instruction.getOperand(1), 0);
+  case MutatorKind::CXX_SubToAdd:
+  case MutatorKind::CXX_SubAssignToAddAssign:
+  case MutatorKind::CXX_PreDecToPreInc:
+  case MutatorKind::CXX_PostDecToPostInc:
+    return instruction.getOpcode() == llvm::Instruction::Sub &&
+           isConstantInt(instruction.getOperand(1), 0);
+  default:
+    return false;
+  }
+}
+
+/// x * 1 and x / 1
+static bool multipliesByOne(MutatorKind kind, llvm::Instruction &instruction) {
+  switch (kind) {
+  case MutatorKind::CXX_MulToDiv:
+  case MutatorKind::CXX_MulAssignToDivAssign:
+    return (instruction.getOpcode() == llvm::Instruction::Mul &&
+            isConstantInt(instruction.getOperand(1), 1)) ||
+           (instruction.getOpcode() == llvm::Instruction::FMul &&
+            isConstantFloatOne(instruction.getOperand(1)));
+  case MutatorKind::CXX_DivToMul:
+  case MutatorKind::CXX_DivAssignToMulAssign:
+    return ((instruction.getOpcode() == llvm::Instruction::SDiv ||
+             instruction.getOpcode() == llvm::Instruction::UDiv) &&
+            isConstantInt(instruction.getOperand(1), 1)) ||
+           (instruction.getOpcode() == llvm::Instruction::FDiv &&
+            isConstantFloatOne(instruction.getOperand(1)));
+  default:
+    return false;
+  }
+}
+
+static bool shiftsByZero(MutatorKind kind, llvm::Instruction &instruction) {
+  switch (kind) {
+  case MutatorKind::CXX_LShiftToRShift:
+  case MutatorKind::CXX_LShiftAssignToRShiftAssign:
+    return instruction.getOpcode() == llvm::Instruction::Shl &&
+           isConstantInt(instruction.getOperand(1), 0);
+  case MutatorKind::CXX_RShiftToLShift:
+  case MutatorKind::CXX_RShiftAssignToLShiftAssign:
+    return (instruction.getOpcode() == llvm::Instruction::LShr ||
+            instruction.getOpcode() == llvm::Instruction::AShr) &&
+           isConstantInt(instruction.getOperand(1), 0);
+  default:
+    return false;
+  }
+}
+
+/// x & x equals x | x, and x ^ 0 equals x | 0
+static bool keepsBitwiseResult(MutatorKind kind, llvm::Instruction &instruction) {
+  switch (kind) {
+  case MutatorKind::CXX_Bitwise_AndToOr:
+  case MutatorKind::CXX_Bitwise_AndAssignToOrAssign:
+    return instruction.getOpcode() == llvm::Instruction::And &&
+           instruction.getOperand(0) == instruction.getOperand(1);
+  case MutatorKind::CXX_Bitwise_OrToAnd:
+  case MutatorKind::CXX_Bitwise_OrAssignToAndAssign:
+    return instruction.getOpcode() == llvm::Instruction::Or &&
+           instruction.getOperand(0) == instruction.getOperand(1);
+  case MutatorKind::CXX_Bitwise_XorToOr:
+  case MutatorKind::CXX_Bitwise_XorAssignToOrAssign:
+    return instruction.getOpcode() == llvm::Instruction::Xor &&
+           isConstantInt(instruction.getOperand(1), 0);
+  default:
+    return false;
+  }
+}
+
+/// The mutators negating a comparison always change its result, so only the ones changing
+/// the strictness are listed
+static bool mutatedPredicate(MutatorKind kind, llvm::CmpInst::Predicate predicate,
+                             llvm::CmpInst::Predicate &mutated) {
+  using Predicate = llvm::CmpInst::Predicate;
+  static const std::vector<std::pair<MutatorKind, std::pair<Predicate, Predicate>>> mutations({
+      { MutatorKind::CXX_LessThanToLessOrEqual, { Predicate::ICMP_SLT, Predicate::ICMP_SLE } },
+      { MutatorKind::CXX_LessThanToLessOrEqual, { Predicate::ICMP_ULT, Predicate::ICMP_ULE } },
+      { MutatorKind::CXX_LessOrEqualToLessThan, { Predicate::ICMP_SLE, Predicate::ICMP_SLT } },
+      { MutatorKind::CXX_LessOrEqualToLessThan, { Predicate::ICMP_ULE, Predicate::ICMP_ULT } },
+      { MutatorKind::CXX_GreaterThanToGreaterOrEqual,
+        { Predicate::ICMP_SGT, Predicate::ICMP_SGE } },
+      { MutatorKind::CXX_GreaterThanToGreaterOrEqual,
+        { Predicate::ICMP_UGT, Predicate::ICMP_UGE } },
+      { MutatorKind::CXX_GreaterOrEqualToGreaterThan,
+        { Predicate::ICMP_SGE, Predicate::ICMP_SGT } },
+      { MutatorKind::CXX_GreaterOrEqualToGreaterThan,
+        { Predicate::ICMP_UGE, Predicate::ICMP_UGT } },
+  });
+  for (auto &mutation : mutations) {
+    if (mutation.first == kind && mutation.second.first == predicate) {
+      mutated = mutation.second.second;
+      return true;
+    }
+  }
+  return false;
+}
+
+/// A comparison of two constants has the same result before and after the mutation if both
+/// predicates fold to the same value
+static bool foldsComparison(MutatorKind kind, llvm::Instruction &instruction) {
+  auto comparison = llvm::dyn_cast<llvm::ICmpInst>(&instruction);
+  llvm::CmpInst::Predicate mutated;
+  if (!comparison || !mutatedPredicate(kind, comparison->getPredicate(), mutated)) {
+    return false;
+  }
+  llvm::Value *lhs = comparison->getOperand(0);
+  llvm::Value *rhs = comparison->getOperand(1);
+  auto lhsConstant = llvm::dyn_cast<llvm::ConstantInt>(lhs);
+  auto rhsConstant = llvm::dyn_cast<llvm::ConstantInt>(rhs);
+  if (!lhsConstant || !rhsConstant) {
+    return false;
+  }
+  return llvm::ConstantExpr::getICmp(comparison->getPredicate(), lhsConstant, rhsConstant) ==
+         llvm::ConstantExpr::getICmp(mutated, lhsConstant, rhsConstant);
+}
+
+EquivalentMutationFilter::EquivalentMutationFilter() {
+  addRule("add zero", addsZero);
+  addRule("multiply by one", multipliesByOne);
+  addRule("shift by zero", shiftsByZero);
+  addRule("same bitwise result", keepsBitwiseResult);
+  addRule("folded comparison", foldsComparison);
+}
+
+void EquivalentMutationFilter::addRule(std::string ruleName, EquivalenceRule rule) {
+  rules.push_back(std::make_unique<Rule>(std::move(ruleName), std::move(rule)));
+}
+
+bool EquivalentMutationFilter::shouldSkip(MutationPoint *point) {
+  auto instruction = llvm::dyn_cast<llvm::Instruction>(point->getOriginalValue());
+  if (!instruction) {
+    return false;
+  }
+  MutatorKind kind = point->getMutator()->mutatorKind();
+  for (auto &rule : rules) {
+    if (rule->matches(kind, *instruction)) {
+      rule->pruned++;
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string EquivalentMutationFilter::name() {
+  return "equivalent mutants";
+}
+
+void EquivalentMutationFilter::reportStatistics(Diagnostics &diagnostics) {
+  size_t total = 0;
+  std::stringstream rulesMessage;
+  for (auto &rule : rules) {
+    size_t pruned = rule->pruned.exchange(0);
+    if (pruned == 0) {
+      continue;
+    }
+    rulesMessage << (total == 0 ? "" : ", ") << rule->name << ": " << pruned;
+    total += pruned;
+  }
+  std::stringstream message;
+  message << "Pruned " << total << " equivalent mutants";
+  if (total != 0) {
+    message << " (" << rulesMessage.str() << ")";
+  }
+  diagnostics.info(message.str());
+}
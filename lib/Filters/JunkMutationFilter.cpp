@@ -4,11 +4,11 @@
 
 using namespace mull;
 
-JunkMutationFilter::JunkMutationFilter(JunkDetector &junkDetector)
-    : junkDetector(junkDetector) {}
+JunkMutationFilter::JunkMutationFilter(JunkDetector &junkDetector, std::string name)
+    : junkDetector(junkDetector), filterName(std::move(name)) {}
 
 bool JunkMutationFilter::shouldSkip(MutationPoint *point) {
   return junkDetector.isJunk(point);
 }
 
-std::string JunkMutationFilter::name() { return "junk"; }
+std::string JunkMutationFilter::name() { return filterName; }
@@ -0,0 +1,10 @@
+#include "mull/Hashing.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/MD5.h>
+
+std::string mull::hexDigest(llvm::MD5 &hash) {
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  return result.digest().str().str();
+}
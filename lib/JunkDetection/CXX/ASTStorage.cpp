@@ -7,6 +7,7 @@
 #include <clang/Basic/FileManager.h>
 #include <clang/Frontend/CompilerInstance.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Path.h>
 #include <sstream>
 
@@ -167,55 +168,158 @@ clang::Decl *ThreadSafeASTUnit::getDecl(clang::SourceLocation &location) {
   return nullptr;
 }
 
+/// The headers of a shared preamble are known to the file manager as well, since the
+/// precompiled header is validated against them
+std::vector<std::string> ThreadSafeASTUnit::getFiles() {
+  std::vector<std::string> files;
+  if (!ast) {
+    return files;
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  clang::FileManager &fileManager = ast->getFileManager();
+  llvm::SmallVector<const clang::FileEntry *, 64> entries;
+  fileManager.GetUniqueIDMapping(entries);
+  for (auto entry : entries) {
+    if (!entry) {
+      continue;
+    }
+    llvm::SmallString<128> path(entry->getName());
+    fileManager.makeAbsolutePath(path);
+    files.push_back(path.str().str());
+  }
+  return files;
+}
+
 ASTStorage::ASTStorage(Diagnostics &diagnostics, const std::string &cxxCompilationDatabasePath,
                        const std::string &cxxCompilationFlags,
                        const std::map<std::string, std::string> &bitcodeCompilationFlags)
     : diagnostics(diagnostics),
       compilationDatabase(CompilationDatabase::fromFile(
-          diagnostics, cxxCompilationDatabasePath, cxxCompilationFlags, bitcodeCompilationFlags)) {}
+          diagnostics, cxxCompilationDatabasePath, cxxCompilationFlags, bitcodeCompilationFlags)),
+      sharedPreambles(diagnostics) {}
 
 ThreadSafeASTUnit *ASTStorage::findAST(const mull::SourceLocation &sourceLocation) {
+  std::string sourceFile = findUnitFile(sourceLocation);
+  if (!sourceFile.empty()) {
+    return findAST(sourceFile);
+  }
+
+  diagnostics.warning("ThreadSafeASTUnit: source location does not exist: " +
+                      sourceLocation.unitFilePath);
+  return nullptr;
+}
+
+std::string ASTStorage::findUnitFile(const mull::SourceLocation &sourceLocation) {
   const std::string &sourceFile = sourceLocation.unitFilePath;
   if (llvm::sys::fs::exists(sourceFile)) {
-    return findAST(sourceFile);
+    return sourceFile;
   }
 
   if (sourceFile == "/in-memory-file.cc") {
-    const std::string &unitSourceFile = sourceLocation.filePath;
-    return findAST(unitSourceFile);
+    return sourceLocation.filePath;
   }
 
-  diagnostics.warning("ThreadSafeASTUnit: source location does not exist: " + sourceFile);
-  return nullptr;
+  return std::string();
+}
+
+std::vector<std::string> ASTStorage::findDependencies(const std::string &sourceFile) {
+  std::vector<std::string> dependencies;
+  ThreadSafeASTUnit *ast = findAST(sourceFile);
+  if (!ast) {
+    return dependencies;
+  }
+  for (auto &file : ast->getFiles()) {
+    if (!sharedPreambles.isTemporary(file)) {
+      dependencies.push_back(file);
+    }
+  }
+  return dependencies;
+}
+
+const CompilationDatabase::Flags &
+ASTStorage::compilationFlagsForFile(const std::string &sourceFile) const {
+  return compilationDatabase.compilationFlagsForFile(sourceFile);
 }
 
 ThreadSafeASTUnit *ASTStorage::findAST(const std::string &sourceFile) {
+  ASTSlot &slot = findSlot(sourceFile);
+  std::call_once(slot.parsed, [&]() { slot.ast = parseAST(sourceFile); });
+  return slot.ast.get();
+}
+
+ASTStorage::ASTSlot &ASTStorage::findSlot(const std::string &sourceFile) {
   std::lock_guard<std::mutex> guard(mutex);
-  if (astUnits.count(sourceFile)) {
-    return astUnits.at(sourceFile).get();
+  std::unique_ptr<ASTSlot> &slot = astUnits[sourceFile];
+  if (!slot) {
+    slot = std::make_unique<ASTSlot>();
   }
+  return *slot;
+}
+
+/// The remapped buffers are owned by the AST unit once it is loaded
+static clang::ASTUnit *
+loadAST(std::vector<const char *> &args,
+        clang::IntrusiveRefCntPtr<clang::DiagnosticsEngine> diagnosticsEngine,
+        llvm::ArrayRef<clang::ASTUnit::RemappedFile> remappedFiles = llvm::None) {
+#if LLVM_VERSION_MAJOR >= 10
+  clang::CaptureDiagsKind captureDiagnostics = clang::CaptureDiagsKind::None;
+#else
+  bool captureDiagnostics = false;
+#endif
+  return clang::ASTUnit::LoadFromCommandLine(args.data(),
+                                             args.data() + args.size(),
+                                             std::make_shared<clang::PCHContainerOperations>(),
+                                             diagnosticsEngine,
+                                             "",
+                                             false,
+                                             captureDiagnostics,
+                                             remappedFiles);
+}
+
+static bool hasErrors(clang::ASTUnit *ast, clang::DiagnosticsEngine &diagnosticsEngine) {
+  return (ast == nullptr) || diagnosticsEngine.hasErrorOccurred() ||
+         diagnosticsEngine.hasUnrecoverableErrorOccurred() ||
+         diagnosticsEngine.hasUncompilableErrorOccurred() ||
+         diagnosticsEngine.hasFatalErrorOccurred();
+}
 
+std::unique_ptr<ThreadSafeASTUnit> ASTStorage::parseAST(const std::string &sourceFile) {
   auto compilationFlags = compilationDatabase.compilationFlagsForFile(sourceFile);
   std::vector<const char *> args({ "mull-cxx" });
   for (auto &flag : compilationFlags) {
     args.push_back(flag.c_str());
   }
+
+  /// A failure with the shared preamble is not reported, the unit is parsed on its own instead
+  std::string blankedContents;
+  std::vector<std::string> preambleFlags =
+      sharedPreambles.flagsFor(sourceFile, compilationFlags, blankedContents);
+  if (!preambleFlags.empty()) {
+    std::vector<const char *> preambleArgs(args);
+    for (auto &flag : preambleFlags) {
+      preambleArgs.push_back(flag.c_str());
+    }
+    preambleArgs.push_back(sourceFile.c_str());
+    clang::IntrusiveRefCntPtr<clang::DiagnosticsEngine> diagnosticsEngine(
+        clang::CompilerInstance::createDiagnostics(new clang::DiagnosticOptions,
+                                                   new clang::IgnoringDiagConsumer));
+    clang::ASTUnit::RemappedFile blankedUnit(
+        sourceFile, llvm::MemoryBuffer::getMemBufferCopy(blankedContents, sourceFile).release());
+    auto ast = loadAST(preambleArgs, diagnosticsEngine, blankedUnit);
+    if (!hasErrors(ast, *diagnosticsEngine)) {
+      return std::make_unique<ThreadSafeASTUnit>(std::unique_ptr<clang::ASTUnit>(ast));
+    }
+    delete ast;
+    sharedPreambles.discard(sourceFile, compilationFlags);
+  }
+
   args.push_back(sourceFile.c_str());
 
   clang::IntrusiveRefCntPtr<clang::DiagnosticsEngine> diagnosticsEngine(
       clang::CompilerInstance::createDiagnostics(new clang::DiagnosticOptions));
 
-  auto ast = clang::ASTUnit::LoadFromCommandLine(args.data(),
-                                                 args.data() + args.size(),
-                                                 std::make_shared<clang::PCHContainerOperations>(),
-                                                 diagnosticsEngine,
-                                                 "");
-
-  bool hasErrors = (ast == nullptr) || diagnosticsEngine->hasErrorOccurred() ||
-                   diagnosticsEngine->hasUnrecoverableErrorOccurred() ||
-                   diagnosticsEngine->hasUncompilableErrorOccurred() ||
-                   diagnosticsEngine->hasFatalErrorOccurred();
-  if (hasErrors) {
+  auto ast = loadAST(args, diagnosticsEngine);
+  if (hasErrors(ast, *diagnosticsEngine)) {
     std::stringstream message;
     message << "Cannot parse file: '" << sourceFile << "':\n";
     for (auto &arg : args) {
@@ -227,12 +331,12 @@ ThreadSafeASTUnit *ASTStorage::findAST(const std::string &sourceFile) {
     diagnostics.warning(message.str());
   }
 
-  auto threadSafeAST = new ThreadSafeASTUnit(std::unique_ptr<clang::ASTUnit>(ast));
-  astUnits[sourceFile] = std::unique_ptr<ThreadSafeASTUnit>(threadSafeAST);
-  return threadSafeAST;
+  return std::make_unique<ThreadSafeASTUnit>(std::unique_ptr<clang::ASTUnit>(ast));
 }
 
 void ASTStorage::setAST(const std::string &sourceFile, std::unique_ptr<ThreadSafeASTUnit> astUnit) {
+  auto slot = std::make_unique<ASTSlot>();
+  std::call_once(slot->parsed, [&]() { slot->ast = std::move(astUnit); });
   std::lock_guard<std::mutex> guard(mutex);
-  astUnits[sourceFile] = std::move(astUnit);
+  astUnits[sourceFile] = std::move(slot);
 }
@@ -0,0 +1,278 @@
+#include "mull/JunkDetection/CXX/CachedJunkDetector.h"
+
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Hashing.h"
+#include "mull/JunkDetection/CXX/ASTStorage.h"
+#include "mull/MutationPoint.h"
+#include "mull/SQLiteUtils.h"
+#include "mull/Version.h"
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+#include <sqlite3.h>
+#include <sstream>
+
+using namespace mull;
+
+static const char *CreateTables = R"CreateTables(
+CREATE TABLE IF NOT EXISTS junk_unit (
+  unit TEXT PRIMARY KEY,
+  flags_hash TEXT
+);
+CREATE TABLE IF NOT EXISTS junk_unit_file (
+  unit TEXT,
+  file TEXT,
+  hash TEXT
+);
+CREATE TABLE IF NOT EXISTS junk_verdict (
+  unit TEXT,
+  mutation TEXT,
+  junk INT,
+  end_line INT,
+  end_column INT,
+  PRIMARY KEY (unit, mutation)
+);
+)CreateTables";
+
+static const char *Description = "junk cache";
+
+static void runStatement(sqlite3_stmt *statement) {
+  sqlite3_step(statement);
+  sqlite3_clear_bindings(statement);
+  sqlite3_reset(statement);
+}
+
+CachedJunkDetector::CachedJunkDetector(Diagnostics &diagnostics, ASTStorage &astStorage,
+                                       JunkDetector &junkDetector, std::string databasePath)
+    : diagnostics(diagnostics), astStorage(astStorage), junkDetector(junkDetector),
+      databasePath(std::move(databasePath)), reused(0) {}
+
+const std::string &CachedJunkDetector::getDatabasePath() const {
+  return databasePath;
+}
+
+void CachedJunkDetector::load() {
+  if (!llvm::sys::fs::exists(databasePath)) {
+    return;
+  }
+  sqlite3 *database = sqlite::openDatabase(diagnostics, databasePath, CreateTables, Description);
+  if (!database) {
+    return;
+  }
+  sqlite3_stmt *statement = nullptr;
+  sqlite3_prepare_v2(
+      database, "SELECT unit, flags_hash FROM junk_unit", -1, &statement, nullptr);
+  while (sqlite3_step(statement) == SQLITE_ROW) {
+    units[sqlite::columnText(statement, 0)].flagsHash = sqlite::columnText(statement, 1);
+  }
+  sqlite3_finalize(statement);
+
+  sqlite3_prepare_v2(
+      database, "SELECT unit, file, hash FROM junk_unit_file", -1, &statement, nullptr);
+  while (sqlite3_step(statement) == SQLITE_ROW) {
+    units[sqlite::columnText(statement, 0)].fileHashes.emplace_back(
+        sqlite::columnText(statement, 1), sqlite::columnText(statement, 2));
+  }
+  sqlite3_finalize(statement);
+
+  sqlite3_prepare_v2(database,
+                     "SELECT unit, mutation, junk, end_line, end_column FROM junk_verdict",
+                     -1,
+                     &statement,
+                     nullptr);
+  while (sqlite3_step(statement) == SQLITE_ROW) {
+    Verdict verdict{ sqlite3_column_int(statement, 2) != 0,
+                     sqlite3_column_int(statement, 3),
+                     sqlite3_column_int(statement, 4) };
+    std::string unit = sqlite::columnText(statement, 0);
+    verdicts[std::make_pair(unit, sqlite::columnText(statement, 1))] = verdict;
+  }
+  sqlite3_finalize(statement);
+  sqlite3_close(database);
+}
+
+void CachedJunkDetector::save() {
+  std::stringstream message;
+  message << "Reused " << reused.exchange(0) << " junk detection results";
+  diagnostics.info(message.str());
+
+  if (newVerdicts.empty()) {
+    return;
+  }
+  llvm::sys::fs::create_directories(llvm::sys::path::parent_path(databasePath), true);
+  sqlite3 *database = sqlite::openDatabase(diagnostics, databasePath, CreateTables, Description);
+  if (!database) {
+    return;
+  }
+  sqlite::execute(diagnostics, database, "BEGIN TRANSACTION", Description);
+
+  /// The verdicts of a changed unit are outdated, even the ones that were not asked for again
+  sqlite3_stmt *removeFiles = nullptr;
+  sqlite3_prepare_v2(
+      database, "DELETE FROM junk_unit_file WHERE unit = ?1", -1, &removeFiles, nullptr);
+  sqlite3_stmt *removeVerdicts = nullptr;
+  sqlite3_prepare_v2(
+      database, "DELETE FROM junk_verdict WHERE unit = ?1", -1, &removeVerdicts, nullptr);
+  sqlite3_stmt *insertUnit = nullptr;
+  sqlite3_prepare_v2(
+      database, "INSERT OR REPLACE INTO junk_unit VALUES (?1, ?2)", -1, &insertUnit, nullptr);
+  sqlite3_stmt *insertFile = nullptr;
+  sqlite3_prepare_v2(
+      database, "INSERT INTO junk_unit_file VALUES (?1, ?2, ?3)", -1, &insertFile, nullptr);
+  for (auto &unit : newUnits) {
+    sqlite3_bind_text(removeFiles, 1, unit.first.c_str(), -1, SQLITE_TRANSIENT);
+    runStatement(removeFiles);
+    sqlite3_bind_text(removeVerdicts, 1, unit.first.c_str(), -1, SQLITE_TRANSIENT);
+    runStatement(removeVerdicts);
+    sqlite3_bind_text(insertUnit, 1, unit.first.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(insertUnit, 2, unit.second.flagsHash.c_str(), -1, SQLITE_TRANSIENT);
+    runStatement(insertUnit);
+    for (auto &fileHash : unit.second.fileHashes) {
+      sqlite3_bind_text(insertFile, 1, unit.first.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text(insertFile, 2, fileHash.first.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text(insertFile, 3, fileHash.second.c_str(), -1, SQLITE_TRANSIENT);
+      runStatement(insertFile);
+    }
+  }
+  sqlite3_finalize(removeFiles);
+  sqlite3_finalize(removeVerdicts);
+  sqlite3_finalize(insertUnit);
+  sqlite3_finalize(insertFile);
+
+  sqlite3_stmt *insertVerdict = nullptr;
+  sqlite3_prepare_v2(database,
+                     "INSERT OR REPLACE INTO junk_verdict VALUES (?1, ?2, ?3, ?4, ?5)",
+                     -1,
+                     &insertVerdict,
+                     nullptr);
+  for (auto &verdict : newVerdicts) {
+    /// A unit that could not be hashed cannot be checked on the next run
+    const std::string &unit = verdict.first.first;
+    if (newUnits.count(unit) == 0 && !isUpToDate(unit)) {
+      continue;
+    }
+    sqlite3_bind_text(insertVerdict, 1, unit.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(insertVerdict, 2, verdict.first.second.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(insertVerdict, 3, verdict.second.junk ? 1 : 0);
+    sqlite3_bind_int(insertVerdict, 4, verdict.second.endLine);
+    sqlite3_bind_int(insertVerdict, 5, verdict.second.endColumn);
+    runStatement(insertVerdict);
+  }
+  sqlite3_finalize(insertVerdict);
+  sqlite::execute(diagnostics, database, "END TRANSACTION", Description);
+  sqlite3_close(database);
+  newUnits.clear();
+  newVerdicts.clear();
+}
+
+bool CachedJunkDetector::isJunk(MutationPoint *point) {
+  if (point->getSourceLocation().isNull()) {
+    return junkDetector.isJunk(point);
+  }
+  std::string unit = astStorage.findUnitFile(point->getSourceLocation());
+  if (unit.empty()) {
+    return junkDetector.isJunk(point);
+  }
+
+  auto key = std::make_pair(unit, point->getUserIdentifier());
+  if (isUpToDate(unit)) {
+    auto verdict = verdicts.find(key);
+    if (verdict != verdicts.end()) {
+      if (!verdict->second.junk) {
+        point->setEndLocation(verdict->second.endLine, verdict->second.endColumn);
+      }
+      reused++;
+      return verdict->second.junk;
+    }
+  }
+
+  bool junk = junkDetector.isJunk(point);
+  recordUnit(unit);
+  const SourceLocation &endLocation = point->getEndLocation();
+  std::lock_guard<std::mutex> lock(mutex);
+  newVerdicts[key] = Verdict{ junk, endLocation.line, endLocation.column };
+  return junk;
+}
+
+CachedJunkDetector::UnitState &CachedJunkDetector::findState(const std::string &unit) {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_ptr<UnitState> &state = states[unit];
+  if (!state) {
+    state = std::make_unique<UnitState>();
+  }
+  return *state;
+}
+
+bool CachedJunkDetector::isUpToDate(const std::string &unit) {
+  UnitState &state = findState(unit);
+  std::call_once(state.checked, [&]() {
+    auto stored = units.find(unit);
+    if (stored == units.end() || stored->second.flagsHash != flagsHash(unit)) {
+      return;
+    }
+    auto &fileHashes = stored->second.fileHashes;
+    state.upToDate = std::all_of(fileHashes.begin(), fileHashes.end(), [&](auto &file) {
+      return fileHash(file.first) == file.second;
+    });
+  });
+  return state.upToDate;
+}
+
+/// The files a unit includes are known once it is parsed, so they are hashed after the first
+/// verdict for the unit
+void CachedJunkDetector::recordUnit(const std::string &unit) {
+  UnitState &state = findState(unit);
+  if (state.upToDate) {
+    return;
+  }
+  std::call_once(state.recorded, [&]() {
+    std::vector<std::string> files = astStorage.findDependencies(unit);
+    if (files.empty()) {
+      return;
+    }
+    Unit record;
+    record.flagsHash = flagsHash(unit);
+    for (auto &file : files) {
+      record.fileHashes.emplace_back(file, fileHash(file));
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    newUnits[unit] = std::move(record);
+  });
+}
+
+/// A new version of Mull may detect junk differently
+std::string CachedJunkDetector::flagsHash(const std::string &unit) {
+  llvm::MD5 hash;
+  hash.update(mullVersionString());
+  hash.update(mullCommitString());
+  for (auto &flag : astStorage.compilationFlagsForFile(unit)) {
+    hash.update("\n");
+    hash.update(flag);
+  }
+  return hexDigest(hash);
+}
+
+/// Most headers are shared by many units, each file is read once per run
+std::string CachedJunkDetector::fileHash(const std::string &path) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto hash = fileHashes.find(path);
+    if (hash != fileHashes.end()) {
+      return hash->second;
+    }
+  }
+  std::string contentHash;
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  if (buffer) {
+    llvm::MD5 hash;
+    hash.update(buffer.get()->getBuffer());
+    contentHash = hexDigest(hash);
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  fileHashes[path] = contentHash;
+  return contentHash;
+}
@@ -0,0 +1,207 @@
+#include "mull/JunkDetection/CXX/SharedPreambles.h"
+
+#include "mull/Diagnostics/Diagnostics.h"
+
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Frontend/Utils.h>
+#include <clang/Lex/Lexer.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+
+using namespace mull;
+
+/// The flags that name the outputs differ between the units, and must not be reused to
+/// precompile a header
+static std::vector<std::string> headerFlags(const std::vector<std::string> &flags) {
+  static const std::vector<std::string> dropped({ "-c", "-S", "-E", "-M", "-MM", "-MD", "-MMD",
+                                                  "-MP" });
+  static const std::vector<std::string> droppedWithValue({ "-o", "-MF", "-MT", "-MQ", "-MJ" });
+  std::vector<std::string> result;
+  for (size_t i = 0; i < flags.size(); i++) {
+    const std::string &flag = flags[i];
+    if (std::find(dropped.begin(), dropped.end(), flag) != dropped.end()) {
+      continue;
+    }
+    if (std::find(droppedWithValue.begin(), droppedWithValue.end(), flag) !=
+        droppedWithValue.end()) {
+      i++;
+      continue;
+    }
+    if (flag.size() > 2 && flag.compare(0, 2, "-o") == 0) {
+      continue;
+    }
+    result.push_back(flag);
+  }
+  return result;
+}
+
+static std::string headerLanguage(const std::string &sourceFile) {
+  return llvm::sys::path::extension(sourceFile) == ".c" ? "c-header" : "c++-header";
+}
+
+/// Returns false if the unit has no preamble worth sharing
+static bool readPreamble(const std::string &sourceFile, std::string &contents, size_t &size) {
+  auto buffer = llvm::MemoryBuffer::getFile(sourceFile);
+  if (!buffer) {
+    return false;
+  }
+  contents = buffer.get()->getBuffer().str();
+  clang::PreambleBounds bounds = clang::Lexer::ComputePreamble(contents, clang::LangOptions());
+  size = bounds.Size;
+  return size != 0 && bounds.PreambleEndsAtStartOfLine;
+}
+
+/// Quoted includes are resolved relative to the unit, so the directory is a part of the key
+static std::string preambleKey(const std::string &sourceFile, const std::vector<std::string> &flags,
+                               const std::string &text) {
+  std::string key = llvm::sys::path::parent_path(sourceFile).str() + "\n" +
+                    headerLanguage(sourceFile) + "\n";
+  for (auto &flag : flags) {
+    key += flag + "\n";
+  }
+  return key + text;
+}
+
+static bool writeFile(const std::string &path, const std::string &contents) {
+  std::error_code error;
+  llvm::raw_fd_ostream stream(path, error, llvm::sys::fs::OpenFlags::F_None);
+  if (error) {
+    return false;
+  }
+  stream << contents;
+  return true;
+}
+
+SharedPreambles::SharedPreambles(Diagnostics &diagnostics) : diagnostics(diagnostics) {}
+
+SharedPreambles::~SharedPreambles() {
+  /// The directories are recorded before the files they contain
+  for (auto it = temporaryFiles.rbegin(); it != temporaryFiles.rend(); ++it) {
+    llvm::sys::fs::remove(*it);
+  }
+}
+
+std::vector<std::string> SharedPreambles::flagsFor(const std::string &sourceFile,
+                                                   const std::vector<std::string> &flags,
+                                                   std::string &blankedContents) {
+  std::string contents;
+  size_t size;
+  if (!readPreamble(sourceFile, contents, size)) {
+    return {};
+  }
+  std::string text = contents.substr(0, size);
+  std::vector<std::string> pchFlags = headerFlags(flags);
+
+  Preamble *preamble = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<Preamble> &slot = preambles[preambleKey(sourceFile, pchFlags, text)];
+    if (!slot) {
+      slot = std::make_unique<Preamble>();
+    }
+    preamble = slot.get();
+    /// Precompiling pays off only if another unit reuses the result
+    if (++preamble->units < 2) {
+      return {};
+    }
+  }
+  std::call_once(preamble->built,
+                 [&]() { preamble->usable = buildPCH(sourceFile, pchFlags, text, *preamble); });
+  if (!preamble->usable) {
+    return {};
+  }
+
+  blankedContents = contents;
+  for (size_t i = 0; i < size; i++) {
+    if (blankedContents[i] != '\n' && blankedContents[i] != '\r') {
+      blankedContents[i] = ' ';
+    }
+  }
+  return { "-include-pch", preamble->pchPath };
+}
+
+void SharedPreambles::discard(const std::string &sourceFile,
+                              const std::vector<std::string> &flags) {
+  std::string contents;
+  size_t size;
+  if (!readPreamble(sourceFile, contents, size)) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  auto preamble =
+      preambles.find(preambleKey(sourceFile, headerFlags(flags), contents.substr(0, size)));
+  if (preamble != preambles.end()) {
+    preamble->second->usable = false;
+  }
+}
+
+bool SharedPreambles::isTemporary(const std::string &path) {
+  std::lock_guard<std::mutex> lock(mutex);
+  return std::find(temporaryFiles.begin(), temporaryFiles.end(), path) != temporaryFiles.end();
+}
+
+bool SharedPreambles::buildPCH(const std::string &sourceFile,
+                               const std::vector<std::string> &flags, const std::string &text,
+                               Preamble &preamble) {
+  /// The header gets a directory of its own, so that its quoted includes cannot be found next
+  /// to it instead of next to the unit
+  llvm::SmallString<128> prefix;
+  llvm::sys::path::system_temp_directory(true, prefix);
+  llvm::sys::path::append(prefix, "mull-preamble");
+  llvm::SmallString<128> directory;
+  if (llvm::sys::fs::createUniqueDirectory(prefix, directory)) {
+    return false;
+  }
+  std::string headerPath = directory.str().str() + "/preamble.h";
+  std::string pchPath = directory.str().str() + "/preamble.pch";
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    temporaryFiles.push_back(directory.str().str());
+    temporaryFiles.push_back(headerPath);
+    temporaryFiles.push_back(pchPath);
+  }
+  if (!writeFile(headerPath, text)) {
+    return false;
+  }
+
+  std::string unitDirectory = llvm::sys::path::parent_path(sourceFile).str();
+  std::string language = headerLanguage(sourceFile);
+  std::vector<const char *> args({ "mull-cxx" });
+  for (auto &flag : flags) {
+    args.push_back(flag.c_str());
+  }
+  for (auto arg : { "-iquote", unitDirectory.c_str(), "-x", language.c_str(),
+                    headerPath.c_str() }) {
+    args.push_back(arg);
+  }
+
+  clang::IntrusiveRefCntPtr<clang::DiagnosticsEngine> diagnosticsEngine(
+      clang::CompilerInstance::createDiagnostics(new clang::DiagnosticOptions,
+                                                 new clang::IgnoringDiagConsumer));
+  std::shared_ptr<clang::CompilerInvocation> invocation =
+      clang::createInvocationFromCommandLine(args, diagnosticsEngine);
+  if (!invocation) {
+    return false;
+  }
+  /// The driver turns any command line into a syntax-only invocation without an output
+  invocation->getFrontendOpts().ProgramAction = clang::frontend::GeneratePCH;
+  invocation->getFrontendOpts().OutputFile = pchPath;
+  clang::CompilerInstance compiler;
+  compiler.setInvocation(invocation);
+  compiler.createDiagnostics(new clang::IgnoringDiagConsumer);
+  clang::GeneratePCHAction action;
+  if (!compiler.ExecuteAction(action) || compiler.getDiagnostics().hasErrorOccurred() ||
+      !llvm::sys::fs::exists(pchPath)) {
+    diagnostics.debug("Cannot precompile the preamble of " + sourceFile +
+                      ", parsing the units sharing it on their own");
+    return false;
+  }
+  preamble.pchPath = pchPath;
+  return true;
+}
@@ -0,0 +1,38 @@
+#include "mull/JunkDetection/IRJunkDetector.h"
+
+#include "mull/MutationPoint.h"
+
+#include <llvm/IR/BasicBlock.h>
+#include <llvm/IR/CFG.h>
+#include <llvm/IR/DebugLoc.h>
+#include <llvm/IR/Instruction.h>
+
+using namespace mull;
+
+/// Compiler temporaries either have no location or an artificial one on line 0
+static bool isCompilerGenerated(const llvm::Instruction &instruction) {
+  const llvm::DebugLoc &location = instruction.getDebugLoc();
+  return !location || location.getLine() == 0;
+}
+
+/// At -O0 the code following a return or a break ends up in blocks nothing jumps to
+static bool isUnreachable(const llvm::Instruction &instruction) {
+  const llvm::BasicBlock *block = instruction.getParent();
+  return block != &block->getParent()->getEntryBlock() &&
+         llvm::pred_begin(block) == llvm::pred_end(block);
+}
+
+/// A value nobody reads: whatever the mutation does to it is never observed
+static bool isUnused(const llvm::Instruction &instruction) {
+  return !instruction.getType()->isVoidTy() && instruction.use_empty() &&
+         !instruction.mayHaveSideEffects();
+}
+
+bool IRJunkDetector::isJunk(MutationPoint *point) {
+  auto instruction = llvm::dyn_cast<llvm::Instruction>(point->getOriginalValue());
+  if (!instruction) {
+    return false;
+  }
+  return isCompilerGenerated(*instruction) || isUnreachable(*instruction) ||
+         isUnused(*instruction);
+}
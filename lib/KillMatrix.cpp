@@ -0,0 +1,146 @@
+#include "mull/KillMatrix.h"
+
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/SQLiteUtils.h"
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+#include <sqlite3.h>
+
+using namespace mull;
+
+static const char *CreateTables = R"CreateTables(
+CREATE TABLE IF NOT EXISTS kill_matrix (
+  mutant TEXT,
+  test TEXT,
+  killed INT,
+  PRIMARY KEY (mutant, test)
+);
+)CreateTables";
+
+static const char *Description = "kill matrix";
+
+KillMatrix::KillMatrix(Diagnostics &diagnostics, std::string databasePath)
+    : diagnostics(diagnostics), databasePath(std::move(databasePath)) {}
+
+const std::string &KillMatrix::getDatabasePath() const {
+  return databasePath;
+}
+
+bool KillMatrix::empty() const {
+  return killingTests.empty();
+}
+
+void KillMatrix::load() {
+  if (!llvm::sys::fs::exists(databasePath)) {
+    return;
+  }
+  sqlite3 *database = sqlite::openDatabase(diagnostics, databasePath, CreateTables, Description);
+  if (!database) {
+    return;
+  }
+  sqlite3_stmt *statement = nullptr;
+  sqlite3_prepare_v2(
+      database, "SELECT mutant, test, killed FROM kill_matrix", -1, &statement, nullptr);
+  while (sqlite3_step(statement) == SQLITE_ROW) {
+    std::set<std::string> &tests = killingTests[sqlite::columnText(statement, 0)];
+    if (sqlite3_column_int(statement, 2) != 0) {
+      tests.insert(sqlite::columnText(statement, 1));
+    }
+  }
+  sqlite3_finalize(statement);
+  sqlite3_close(database);
+}
+
+void KillMatrix::save() {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (newRows.empty()) {
+    return;
+  }
+  llvm::sys::fs::create_directories(llvm::sys::path::parent_path(databasePath), true);
+  sqlite3 *database = sqlite::openDatabase(diagnostics, databasePath, CreateTables, Description);
+  if (!database) {
+    return;
+  }
+  sqlite::execute(diagnostics, database, "BEGIN TRANSACTION", Description);
+  sqlite3_stmt *remove = nullptr;
+  sqlite3_prepare_v2(
+      database, "DELETE FROM kill_matrix WHERE mutant = ?1", -1, &remove, nullptr);
+  sqlite3_stmt *insert = nullptr;
+  sqlite3_prepare_v2(
+      database, "INSERT INTO kill_matrix VALUES (?1, ?2, ?3)", -1, &insert, nullptr);
+  for (auto &row : newRows) {
+    sqlite3_bind_text(remove, 1, row.first.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_step(remove);
+    sqlite3_clear_bindings(remove);
+    sqlite3_reset(remove);
+    for (auto &cell : row.second) {
+      sqlite3_bind_text(insert, 1, row.first.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text(insert, 2, cell.first.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_int(insert, 3, cell.second ? 1 : 0);
+      sqlite3_step(insert);
+      sqlite3_clear_bindings(insert);
+      sqlite3_reset(insert);
+    }
+  }
+  sqlite3_finalize(remove);
+  sqlite3_finalize(insert);
+  sqlite::execute(diagnostics, database, "END TRANSACTION", Description);
+  sqlite3_close(database);
+  newRows.clear();
+}
+
+void KillMatrix::recordRun(const std::string &mutant, const std::string &test, bool killed) {
+  std::lock_guard<std::mutex> lock(mutex);
+  newRows[mutant][test] = killed;
+}
+
+/// The mutants killed by the same tests are grouped first, so that the sets are compared
+/// pairwise only among the distinct ones
+std::unordered_map<std::string, std::vector<std::string>>
+KillMatrix::subsumedMutants(const std::vector<std::string> &mutants) const {
+  std::map<std::set<std::string>, std::string> firstKilled;
+  std::vector<std::pair<const std::string *, const std::set<std::string> *>> killedMutants;
+  for (auto &mutant : mutants) {
+    auto row = killingTests.find(mutant);
+    if (row == killingTests.end() || row->second.empty()) {
+      continue;
+    }
+    firstKilled.emplace(row->second, mutant);
+    killedMutants.emplace_back(&mutant, &row->second);
+  }
+
+  /// The sets that have no proper subset among the others
+  std::vector<std::pair<const std::set<std::string> *, const std::string *>> minimalSets;
+  for (auto &candidate : firstKilled) {
+    bool minimal = std::none_of(firstKilled.begin(), firstKilled.end(), [&](auto &other) {
+      return other.first.size() < candidate.first.size() &&
+             std::includes(candidate.first.begin(),
+                           candidate.first.end(),
+                           other.first.begin(),
+                           other.first.end());
+    });
+    if (minimal) {
+      minimalSets.emplace_back(&candidate.first, &candidate.second);
+    }
+  }
+
+  std::unordered_map<std::string, std::vector<std::string>> subsumed;
+  for (auto &killed : killedMutants) {
+    const std::set<std::string> &tests = *killed.second;
+    std::vector<std::string> dominators;
+    for (auto &minimal : minimalSets) {
+      if (*minimal.second != *killed.first &&
+          std::includes(tests.begin(), tests.end(), minimal.first->begin(), minimal.first->end())) {
+        dominators.push_back(*minimal.second);
+      }
+    }
+    if (!dominators.empty()) {
+      std::sort(dominators.begin(), dominators.end());
+      subsumed[*killed.first] = std::move(dominators);
+    }
+  }
+  return subsumed;
+}
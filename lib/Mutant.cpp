@@ -31,6 +31,10 @@ bool Mutant::isCovered() const {
   return covered;
 }
 
+void Mutant::setCovered(bool isCovered) {
+  covered = isCovered;
+}
+
 void Mutant::setMutatorKind(MutatorKind kind) {
   mutatorKind = kind;
 }
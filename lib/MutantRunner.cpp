@@ -1,11 +1,52 @@
 #include "mull/MutantRunner.h"
+#include "mull/KillMatrix.h"
 #include "mull/Parallelization/TaskExecutor.h"
 #include "mull/Parallelization/Tasks/MutantExecutionTask.h"
+#include "mull/Parallelization/Tasks/TestCoverageTask.h"
+#include "mull/Runtime/ReachabilityRuntime.h"
+#include "mull/TestHistory.h"
+#include "mull/Toolchain/TestFramework.h"
+
+#include <algorithm>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+#include <sstream>
 
 using namespace mull;
 
-MutantRunner::MutantRunner(Diagnostics &diagnostics, const Configuration &configuration)
-    : diagnostics(diagnostics), configuration(configuration), runner(diagnostics) {}
+MutantRunner::MutantRunner(Diagnostics &diagnostics, const Configuration &configuration,
+                           ThreadPool *threadPool, const ReachabilitySlots *reachabilitySlots)
+    : diagnostics(diagnostics), configuration(configuration), runner(diagnostics),
+      threadPool(threadPool), reachabilitySlots(reachabilitySlots) {}
+
+/// The probes cannot grow the file, it must be as large as the bitmap beforehand
+static bool createReachabilityBitmap(Diagnostics &diagnostics, size_t size, std::string &path) {
+  llvm::SmallString<128> bitmapPath;
+  int descriptor;
+  if (auto error = llvm::sys::fs::createTemporaryFile(
+          "mull-reachability", "bitmap", descriptor, bitmapPath)) {
+    diagnostics.warning("Cannot create reachability bitmap: " + error.message());
+    return false;
+  }
+  llvm::raw_fd_ostream stream(descriptor, true);
+  stream << std::string(size, '\0');
+  stream.close();
+  path = bitmapPath.str().str();
+  return true;
+}
+
+static bool readReachabilityBitmap(Diagnostics &diagnostics, const std::string &path,
+                                   std::string &bitmap) {
+  auto buffer = llvm::MemoryBuffer::getFile(path);
+  llvm::sys::fs::remove(path);
+  if (!buffer) {
+    diagnostics.warning("Cannot read reachability bitmap: " + buffer.getError().message());
+    return false;
+  }
+  bitmap = buffer.get()->getBuffer().str();
+  return true;
+}
 
 std::vector<std::unique_ptr<MutationResult>>
 MutantRunner::runMutants(const std::string &executable,
@@ -30,24 +71,286 @@ MutantRunner::runMutants(const std::string &executable, const std::vector<std::s
   });
 
   ExecutionResult baseline;
+  std::string bitmap;
+  bool reachabilityKnown = false;
   singleTask.execute("Baseline run", [&]() {
+    std::string bitmapPath;
+    std::vector<std::pair<std::string, std::string>> environment;
+    if (reachabilitySlots && reachabilitySlots->size() != 0 &&
+        createReachabilityBitmap(diagnostics, reachabilitySlots->size(), bitmapPath)) {
+      environment.emplace_back(ReachabilityEnvironmentVariable, bitmapPath);
+    }
     baseline = runner.runProgram(executable,
                                  extraArgs,
                                  {},
                                  configuration.timeout,
                                  configuration.captureMutantOutput,
-                                 std::nullopt);
+                                 std::nullopt,
+                                 environment);
+    if (!bitmapPath.empty()) {
+      reachabilityKnown = readReachabilityBitmap(diagnostics, bitmapPath, bitmap);
+    }
   });
+  /// A failing run may stop before it reaches the code the tests would otherwise execute
+  if (reachabilityKnown && baseline.status == Passed) {
+    markUnreachedMutants(bitmap, mutants);
+  }
+
+  TestFramework testFramework(configuration.testFramework);
+  CoveringTests coveringTests;
+  std::unordered_set<std::string> wholeProgramMutants;
+  std::unordered_map<std::string, long long> durations;
+  bool selectTests = configuration.testFramework != TestFrameworkKind::None &&
+                     collectCoveringTests(executable,
+                                          extraArgs,
+                                          testFramework,
+                                          coveringTests,
+                                          wholeProgramMutants,
+                                          durations);
+  if (selectTests && configuration.forkServer) {
+    diagnostics.warning("The fork server cannot select tests, mutants will run without it");
+  }
+
+  std::unique_ptr<TestHistory> testHistory;
+  if (selectTests && !configuration.testHistory.empty()) {
+    testHistory = std::make_unique<TestHistory>(diagnostics, configuration.testHistory);
+    singleTask.execute("Loading test history", [&]() { testHistory->load(); });
+  }
+  std::unique_ptr<KillMatrix> killMatrix;
+  if (selectTests && !configuration.killMatrix.empty()) {
+    killMatrix = std::make_unique<KillMatrix>(diagnostics, configuration.killMatrix);
+    singleTask.execute("Loading kill matrix", [&]() { killMatrix->load(); });
+  }
+  TestSelection testSelection{ testFramework, coveringTests,     wholeProgramMutants,
+                               durations,     testHistory.get(), killMatrix.get() };
 
   std::vector<std::unique_ptr<MutationResult>> mutationResults;
+  if (killMatrix && !killMatrix->empty()) {
+    executeDominatorsFirst(
+        executable, extraArgs, baseline, testSelection, *killMatrix, mutants, mutationResults);
+  } else {
+    executeMutants(executable,
+                   extraArgs,
+                   baseline,
+                   selectTests ? &testSelection : nullptr,
+                   mutants,
+                   mutationResults);
+  }
+
+  if (testHistory) {
+    singleTask.execute("Saving test history", [&]() { testHistory->save(); });
+    diagnostics.info("Test history can be found at '" + testHistory->getDatabasePath() + "'");
+  }
+  if (killMatrix) {
+    singleTask.execute("Saving kill matrix", [&]() { killMatrix->save(); });
+    diagnostics.info("Kill matrix can be found at '" + killMatrix->getDatabasePath() + "'");
+  }
+
+  return mutationResults;
+}
+
+void MutantRunner::executeMutants(const std::string &executable,
+                                  const std::vector<std::string> &extraArgs,
+                                  ExecutionResult &baseline, const TestSelection *testSelection,
+                                  const std::vector<std::unique_ptr<Mutant>> &mutants,
+                                  std::vector<std::unique_ptr<MutationResult>> &mutationResults) {
   std::vector<MutantExecutionTask> tasks;
+  if (configuration.workerCommands.empty()) {
+    tasks.reserve(configuration.parallelization.mutantExecutionWorkers);
+    for (int i = 0; i < configuration.parallelization.mutantExecutionWorkers; i++) {
+      tasks.emplace_back(
+          configuration, diagnostics, executable, baseline, extraArgs, testSelection);
+    }
+  } else {
+    if (configuration.forkServer) {
+      diagnostics.warning("The fork server is not used with workers");
+    }
+    /// One task per worker, each one keeps its worker busy with one mutant at a time
+    tasks.reserve(configuration.workerCommands.size());
+    for (auto &workerCommand : configuration.workerCommands) {
+      tasks.emplace_back(configuration,
+                         diagnostics,
+                         executable,
+                         baseline,
+                         extraArgs,
+                         testSelection,
+                         workerCommand);
+    }
+  }
+  TaskExecutor<MutantExecutionTask> mutantRunner(diagnostics,
+                                                 "Running mutants",
+                                                 mutants,
+                                                 mutationResults,
+                                                 std::move(tasks),
+                                                 TaskScheduling::Dynamic);
+  /// The tasks only wait for the workers, the pool may have fewer threads than there are workers
+  mutantRunner.execute(configuration.workerCommands.empty() ? threadPool : nullptr);
+}
+
+static bool isKilled(ExecutionStatus status) {
+  return status == Failed || status == Timedout || status == Crashed || status == AbnormalExit;
+}
+
+void MutantRunner::executeDominatorsFirst(
+    const std::string &executable, const std::vector<std::string> &extraArgs,
+    ExecutionResult &baseline, const TestSelection &testSelection, const KillMatrix &killMatrix,
+    std::vector<std::unique_ptr<Mutant>> &mutants,
+    std::vector<std::unique_ptr<MutationResult>> &mutationResults) {
+  std::vector<std::string> identifiers;
+  for (auto &mutant : mutants) {
+    identifiers.push_back(mutant->getIdentifier());
+  }
+  std::unordered_map<std::string, std::vector<std::string>> subsumed =
+      killMatrix.subsumedMutants(identifiers);
+
+  std::vector<std::unique_ptr<Mutant>> dominators;
+  std::vector<std::unique_ptr<Mutant>> subsumedMutants;
+  for (auto &mutant : mutants) {
+    if (subsumed.count(mutant->getIdentifier())) {
+      subsumedMutants.push_back(std::move(mutant));
+    } else {
+      dominators.push_back(std::move(mutant));
+    }
+  }
+  executeMutants(executable, extraArgs, baseline, &testSelection, dominators, mutationResults);
+
+  std::unordered_map<std::string, const ExecutionResult *> killedDominators;
+  for (auto &mutationResult : mutationResults) {
+    if (isKilled(mutationResult->getExecutionResult().status)) {
+      killedDominators[mutationResult->getMutant()->getIdentifier()] =
+          &mutationResult->getExecutionResult();
+    }
+  }
+  std::vector<std::unique_ptr<MutationResult>> inferredResults;
+  std::vector<std::unique_ptr<Mutant>> rerunMutants;
+  std::vector<std::unique_ptr<Mutant>> inferredMutants;
+  for (auto &mutant : subsumedMutants) {
+    const ExecutionResult *killedBy = nullptr;
+    for (auto &dominator : subsumed.at(mutant->getIdentifier())) {
+      auto killed = killedDominators.find(dominator);
+      if (killed != killedDominators.end()) {
+        killedBy = killed->second;
+        break;
+      }
+    }
+    if (!killedBy) {
+      /// The tests or the code changed since the matrix was recorded
+      rerunMutants.push_back(std::move(mutant));
+      continue;
+    }
+    ExecutionResult result = *killedBy;
+    result.source = StatusSource::Inferred;
+    result.runningTime = 0;
+    inferredResults.push_back(std::make_unique<MutationResult>(result, mutant.get()));
+    inferredMutants.push_back(std::move(mutant));
+  }
+  if (!rerunMutants.empty()) {
+    executeMutants(
+        executable, extraArgs, baseline, &testSelection, rerunMutants, mutationResults);
+  }
+
+  std::stringstream message;
+  message << "Inferred the status of " << inferredMutants.size() << " subsumed mutants, ran "
+          << dominators.size() + rerunMutants.size() << " mutants";
+  diagnostics.info(message.str());
+
+  /// The mutants are owned by the caller, the results only point to them
+  mutants.clear();
+  std::move(dominators.begin(), dominators.end(), std::back_inserter(mutants));
+  std::move(rerunMutants.begin(), rerunMutants.end(), std::back_inserter(mutants));
+  std::move(inferredMutants.begin(), inferredMutants.end(), std::back_inserter(mutants));
+  std::sort(std::begin(mutants), std::end(mutants), MutantComparator());
+  std::move(inferredResults.begin(), inferredResults.end(), std::back_inserter(mutationResults));
+}
+
+void MutantRunner::markUnreachedMutants(const std::string &bitmap,
+                                        std::vector<std::unique_ptr<Mutant>> &mutants) {
+  std::unordered_set<std::string> unreached = reachabilitySlots->unreachedMutants(bitmap);
+  size_t coveredMutants = 0;
+  size_t unreachedMutants = 0;
+  for (auto &mutant : mutants) {
+    if (!mutant->isCovered()) {
+      continue;
+    }
+    coveredMutants++;
+    if (unreached.count(mutant->getIdentifier())) {
+      mutant->setCovered(false);
+      unreachedMutants++;
+    }
+  }
+  std::stringstream message;
+  message << "The tests never reach " << unreachedMutants << " of " << coveredMutants
+          << " covered mutants";
+  diagnostics.info(message.str());
+}
+
+bool MutantRunner::collectCoveringTests(const std::string &executable,
+                                        const std::vector<std::string> &extraArgs,
+                                        const TestFramework &testFramework,
+                                        CoveringTests &coveringTests,
+                                        std::unordered_set<std::string> &wholeProgramMutants,
+                                        std::unordered_map<std::string, long long> &durations) {
+  SingleTaskExecutor singleTask(diagnostics);
+  std::vector<std::string> tests;
+  singleTask.execute("Listing tests", [&]() {
+    tests = testFramework.listTests(runner, executable, extraArgs, configuration.timeout);
+  });
+  if (tests.empty()) {
+    diagnostics.warning("Cannot list the tests, each mutant will run against the whole program");
+    return false;
+  }
+
+  std::vector<TestCoverage> coverage;
+  std::vector<TestCoverageTask> tasks;
   tasks.reserve(configuration.parallelization.mutantExecutionWorkers);
   for (int i = 0; i < configuration.parallelization.mutantExecutionWorkers; i++) {
-    tasks.emplace_back(configuration, diagnostics, executable, baseline, extraArgs);
+    tasks.emplace_back(configuration, diagnostics, executable, extraArgs, testFramework);
   }
-  TaskExecutor<MutantExecutionTask> mutantRunner(
-      diagnostics, "Running mutants", mutants, mutationResults, std::move(tasks));
-  mutantRunner.execute();
+  TaskExecutor<TestCoverageTask> coverageCollector(diagnostics,
+                                                   "Collecting per-test coverage",
+                                                   tests,
+                                                   coverage,
+                                                   std::move(tasks),
+                                                   TaskScheduling::Dynamic);
+  coverageCollector.execute(threadPool);
 
-  return mutationResults;
+  for (auto &testCoverage : coverage) {
+    if (!testCoverage.coverageKnown) {
+      diagnostics.warning("Cannot collect the coverage of a test, each mutant will run against "
+                          "the whole program: " +
+                          testCoverage.test);
+      return false;
+    }
+  }
+
+  size_t passedTests = 0;
+  for (auto &testCoverage : coverage) {
+    /// A test that fails on its own would kill every mutant it reaches, yet it may pass as part
+    /// of the whole program, so the mutants it reaches run against the whole program instead
+    if (testCoverage.result.status != Passed) {
+      diagnostics.warning("Test fails when run on its own, the mutants it reaches will run "
+                          "against the whole program: " +
+                          testCoverage.test);
+      wholeProgramMutants.insert(testCoverage.mutants.begin(), testCoverage.mutants.end());
+      continue;
+    }
+    passedTests++;
+    durations[testCoverage.test] = testCoverage.result.runningTime;
+    for (auto &identifier : testCoverage.mutants) {
+      coveringTests[identifier].push_back(testCoverage.test);
+    }
+  }
+  if (passedTests == 0) {
+    diagnostics.warning("None of the tests pass on their own, each mutant will run against the "
+                        "whole program");
+    return false;
+  }
+
+  std::stringstream message;
+  message << passedTests << " tests reach " << coveringTests.size() << " mutants";
+  if (!wholeProgramMutants.empty()) {
+    message << ", " << wholeProgramMutants.size() << " mutants run against the whole program";
+  }
+  diagnostics.info(message.str());
+  return true;
 }
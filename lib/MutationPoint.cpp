@@ -6,6 +6,7 @@
 #include "mull/Reporters/SourceManager.h"
 #include "mull/Toolchain/Compiler.h"
 
+#include <irm/irm.h>
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/Function.h>
 #include <llvm/Transforms/Utils/Cloning.h>
@@ -81,7 +82,7 @@ MutationPoint::MutationPoint(Mutator *mutator, irm::IRMutation *irMutator,
     : mutator(mutator), address(MutationPointAddress::addressFromInstruction(instruction)),
       bitcode(m), originalFunction(instruction->getFunction()), mutatedFunction(nullptr),
       sourceLocation(SourceLocation::locationFromInstruction(instruction)), irMutator(irMutator),
-      covered(true), endLocation(SourceLocation::nullSourceLocation()) {
+      covered(true), schemataIndex(0), endLocation(SourceLocation::nullSourceLocation()) {
   userIdentifier = mutator->getUniqueIdentifier() + ':' + sourceLocation.filePath + ':' +
                    std::to_string(sourceLocation.line) + ':' +
                    std::to_string(sourceLocation.column);
@@ -122,9 +123,18 @@ Bitcode *MutationPoint::getBitcode() const {
 
 void MutationPoint::applyMutation() {
   assert(mutatedFunction != nullptr);
+  /// Schemata mutations are applied while cloning the function
+  if (schemataIndex != 0) {
+    return;
+  }
   mutator->applyMutation(mutatedFunction, address, irMutator);
 }
 
+void MutationPoint::applySchemataMutation(llvm::Instruction *instruction) {
+  assert(mutator->isInstructionLocal());
+  irMutator->mutate(instruction);
+}
+
 void MutationPoint::setEndLocation(int line, int column) {
   endLocation = SourceLocation(sourceLocation.unitDirectory,
                                sourceLocation.unitFilePath,
@@ -180,6 +190,19 @@ void MutationPoint::setMutatedFunction(llvm::Function *function) {
   this->mutatedFunction = function;
 }
 
+void MutationPoint::setMutantSchemata(llvm::Function *function, int index) {
+  this->mutatedFunction = function;
+  this->schemataIndex = index;
+}
+
+int MutationPoint::getSchemataIndex() const {
+  return schemataIndex;
+}
+
+std::string MutationPoint::getSchemataSelectorName() const {
+  return "mull_" + originalFunction->getName().str() + "_active_mutant";
+}
+
 std::string MutationPoint::getMutatedFunctionName() {
   if (this->mutatedFunction) {
     return this->mutatedFunction->getName().str();
@@ -188,7 +211,7 @@ std::string MutationPoint::getMutatedFunctionName() {
 }
 
 std::string MutationPoint::getOriginalFunctionName() const {
-  return "mull_"s + originalFunction->getName().str() + "_original";
+  return "mull_" + originalFunction->getName().str() + "_original";
 }
 
 std::string MutationPoint::dump() const {
@@ -14,7 +14,8 @@ MutationsFinder::MutationsFinder(std::vector<std::unique_ptr<Mutator>> mutators,
 
 std::vector<MutationPoint *>
 MutationsFinder::getMutationPoints(Diagnostics &diagnostics, const Program &program,
-                                   std::vector<FunctionUnderTest> &functions) {
+                                   std::vector<FunctionUnderTest> &functions,
+                                   ThreadPool *threadPool) {
   std::vector<SearchMutationPointsTask> tasks;
   tasks.reserve(config.parallelization.workers);
   for (int i = 0; i < config.parallelization.workers; i++) {
@@ -23,7 +24,7 @@ MutationsFinder::getMutationPoints(Diagnostics &diagnostics, const Program &prog
 
   TaskExecutor<SearchMutationPointsTask> finder(
       diagnostics, "Searching mutants across functions", functions, ownedPoints, tasks);
-  finder.execute();
+  finder.execute(threadPool);
 
   std::vector<MutationPoint *> mutationPoints;
   for (auto &point : ownedPoints) {
@@ -32,3 +33,7 @@ MutationsFinder::getMutationPoints(Diagnostics &diagnostics, const Program &prog
 
   return mutationPoints;
 }
+
+void MutationsFinder::releaseMutationPoints() {
+  ownedPoints.clear();
+}
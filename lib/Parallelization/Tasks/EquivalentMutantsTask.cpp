@@ -0,0 +1,90 @@
+#include "mull/Parallelization/Tasks/EquivalentMutantsTask.h"
+
+#include "mull/Hashing.h"
+#include "mull/MutationPoint.h"
+#include "mull/Parallelization/Progress.h"
+
+#include <llvm/IR/DebugInfo.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Transforms/IPO/PassManagerBuilder.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+
+using namespace mull;
+
+void EquivalentMutantsTask::operator()(iterator begin, iterator end, Out &storage,
+                                       progress_counter &counter) {
+  for (auto it = begin; it != end; it++, counter.increment()) {
+    Bitcode &bitcode = **it;
+    fingerprintMutants(bitcode, storage);
+  }
+}
+
+/// Optimizes a copy of the function the same way the compiler optimizes the mutated functions,
+/// and hashes its text. Everything that differs between an original function and its mutated
+/// clones regardless of the code (the name, linkage, debug info, value names) is normalized.
+static std::string optimizedCodeHash(llvm::Function &function,
+                                     llvm::legacy::FunctionPassManager &passManager) {
+  llvm::ValueToValueMapTy map;
+  llvm::Function *copy = llvm::CloneFunction(&function, map);
+  copy->setName("mull_equivalence_copy");
+  copy->setLinkage(llvm::GlobalValue::InternalLinkage);
+  copy->setComdat(nullptr);
+
+  passManager.run(*copy);
+
+  llvm::stripDebugInfo(*copy);
+  for (auto &argument : copy->args()) {
+    argument.setName("");
+  }
+  for (auto &basicBlock : *copy) {
+    basicBlock.setName("");
+    for (auto &instruction : basicBlock) {
+      instruction.setName("");
+    }
+  }
+
+  std::string text;
+  llvm::raw_string_ostream stream(text);
+  copy->print(stream);
+  stream.flush();
+  /// The name is reused by the next copy
+  copy->eraseFromParent();
+
+  llvm::MD5 hash;
+  hash.update(text);
+  return hexDigest(hash);
+}
+
+void EquivalentMutantsTask::fingerprintMutants(Bitcode &bitcode, Out &storage) {
+  llvm::Module *module = bitcode.getModule();
+  llvm::legacy::FunctionPassManager passManager(module);
+  llvm::PassManagerBuilder builder;
+  builder.OptLevel = 2;
+  builder.populateFunctionPassManager(passManager);
+  passManager.doInitialization();
+
+  for (auto &pair : bitcode.getMutationPointsMap()) {
+    std::string originalHash;
+    for (MutationPoint *point : pair.second) {
+      if (!point->isCovered() || point->getMutatedFunction() == nullptr ||
+          point->getSchemataIndex() != 0) {
+        continue;
+      }
+      if (originalHash.empty()) {
+        llvm::Function *originalCopy = module->getFunction(point->getOriginalFunctionName());
+        assert(originalCopy && "The original function should be present");
+        originalHash = optimizedCodeHash(*originalCopy, passManager);
+      }
+      std::string mutantHash = optimizedCodeHash(*point->getMutatedFunction(), passManager);
+      storage.push_back({ point,
+                          bitcode.getUniqueIdentifier() + ":" + pair.first->getName().str() +
+                              ":" + mutantHash,
+                          mutantHash == originalHash });
+    }
+  }
+
+  passManager.doFinalization();
+}
@@ -4,8 +4,6 @@
 #include "mull/Diagnostics/Diagnostics.h"
 #include "mull/Parallelization/Progress.h"
 
-#include <ebc/EmbeddedFile.h>
-
 #include <llvm/Support/MemoryBuffer.h>
 
 namespace mull {
@@ -13,17 +11,13 @@ namespace mull {
 void LoadBitcodeFromBinaryTask::operator()(iterator begin, iterator end, Out &storage,
                                            mull::progress_counter &counter) {
   for (auto it = begin; it != end; it++, counter.increment()) {
-    auto pair = (*it)->GetRawBuffer();
-    const auto data = pair.first;
-    const auto size = pair.second;
-    assert(data);
-    assert(size);
-
-    llvm::StringRef bufferView(data, size);
-    auto ownedBuffer = llvm::MemoryBuffer::getMemBufferCopy(bufferView);
-    auto buffer = ownedBuffer.get();
+    assert(it->getBufferSize() != 0);
+
+    /// The buffer does not own the memory, the bitcode stays in the memory mapped executable
+    auto buffer = llvm::MemoryBuffer::getMemBuffer(*it, false);
     auto context = std::make_unique<llvm::LLVMContext>();
-    auto module = mull::loadModuleFromBuffer(*context, *buffer, diagnostics);
+    /// Only the functions that pass the function filters are materialized, see Driver
+    auto module = mull::loadLazyModuleFromBuffer(*context, std::move(buffer), diagnostics);
 
     if (module == nullptr) {
       diagnostics.warning("Bitcode module could not be loaded. Possible reason: the bitcode "
@@ -0,0 +1,36 @@
+#include "mull/Parallelization/Tasks/MaterializeFunctionsTask.h"
+
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Parallelization/Progress.h"
+
+using namespace mull;
+using namespace llvm;
+
+MaterializeFunctionsTask::MaterializeFunctionsTask(
+    Diagnostics &diagnostics, const std::unordered_set<llvm::Function *> *functions)
+    : diagnostics(diagnostics), functions(functions) {}
+
+void MaterializeFunctionsTask::operator()(iterator begin, iterator end, Out &storage,
+                                          progress_counter &counter) {
+  for (auto it = begin; it != end; it++, counter.increment()) {
+    Module *module = (*it)->getModule();
+    if (!module->getMaterializer()) {
+      continue;
+    }
+    if (!functions) {
+      if (Error error = module->materializeAll()) {
+        diagnostics.warning("Cannot materialize module: " + toString(std::move(error)));
+      }
+      continue;
+    }
+    for (Function &function : *module) {
+      if (!function.isMaterializable() || functions->count(&function) == 0) {
+        continue;
+      }
+      if (Error error = function.materialize()) {
+        diagnostics.warning("Cannot materialize function " + function.getName().str() + ": " +
+                            toString(std::move(error)));
+      }
+    }
+  }
+}
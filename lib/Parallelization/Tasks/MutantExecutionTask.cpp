@@ -2,8 +2,13 @@
 
 #include "mull/Config/Configuration.h"
 #include "mull/Diagnostics/Diagnostics.h"
+#include "mull/KillMatrix.h"
 #include "mull/Parallelization/Progress.h"
+#include "mull/Toolchain/ForkServer.h"
 #include "mull/Toolchain/Runner.h"
+#include "mull/TestHistory.h"
+#include "mull/Toolchain/TestFramework.h"
+#include "mull/Toolchain/Worker.h"
 
 using namespace mull;
 using namespace std::string_literals;
@@ -11,26 +16,115 @@ using namespace std::string_literals;
 MutantExecutionTask::MutantExecutionTask(const Configuration &configuration,
                                          Diagnostics &diagnostics, const std::string &executable,
                                          ExecutionResult &baseline,
-                                         const std::vector<std::string> &extraArgs)
+                                         const std::vector<std::string> &extraArgs,
+                                         const TestSelection *testSelection,
+                                         std::string workerCommand)
     : configuration(configuration), diagnostics(diagnostics), executable(executable),
-      baseline(baseline), extraArgs(extraArgs) {}
+      baseline(baseline), extraArgs(extraArgs), testSelection(testSelection),
+      workerCommand(std::move(workerCommand)) {}
+
+MutantExecutionTask::MutantExecutionTask(MutantExecutionTask &&) noexcept = default;
+
+MutantExecutionTask::~MutantExecutionTask() = default;
 
 void MutantExecutionTask::operator()(iterator begin, iterator end, Out &storage,
                                      progress_counter &counter) {
   Runner runner(diagnostics);
+  if (!forkServer) {
+    forkServer = std::make_unique<ForkServer>(diagnostics);
+    /// The fork server runs the whole test program, so it cannot select tests per mutant
+    if (configuration.forkServer && !testSelection && workerCommand.empty() &&
+        !forkServer->start(executable, extraArgs, configuration.timeout)) {
+      diagnostics.warning("Cannot start fork server, falling back to regular execution: "s +
+                          executable);
+    }
+  }
+  if (!worker) {
+    worker = std::make_unique<Worker>(diagnostics);
+    if (!workerCommand.empty() &&
+        !worker->start(
+            workerCommand, executable, configuration.captureMutantOutput, configuration.timeout)) {
+      diagnostics.warning("Cannot start worker, running the mutants locally: " + workerCommand);
+    }
+  }
   for (auto it = begin; it != end; ++it, counter.increment()) {
     auto &mutant = *it;
     ExecutionResult result;
-    if (mutant->isCovered()) {
-      result = runner.runProgram(executable,
-                                 extraArgs,
-                                 { mutant->getIdentifier() },
-                                 baseline.runningTime * 10,
-                                 configuration.captureMutantOutput,
-                                 std::nullopt);
-    } else {
+    if (!mutant->isCovered()) {
       result.status = NotCovered;
+    } else if (testSelection &&
+               testSelection->wholeProgramMutants.count(mutant->getIdentifier())) {
+      result = runMutant(runner, *mutant, extraArgs);
+    } else if (testSelection) {
+      auto tests = testSelection->coveringTests.find(mutant->getIdentifier());
+      if (tests == testSelection->coveringTests.end()) {
+        result.status = NotCovered;
+      } else {
+        result = runTests(runner, *mutant, tests->second);
+      }
+    } else if (!forkServer->runMutant(mutant->getIdentifier(), baseline.runningTime * 10, result)) {
+      result = runMutant(runner, *mutant, extraArgs);
     }
     storage.push_back(std::make_unique<MutationResult>(result, mutant.get()));
   }
 }
+
+ExecutionResult MutantExecutionTask::runTests(Runner &runner, const Mutant &mutant,
+                                              const std::vector<std::string> &tests) {
+  TestHistory *testHistory = testSelection->testHistory;
+  KillMatrix *killMatrix = testSelection->killMatrix;
+  if (!testHistory && !killMatrix) {
+    std::vector<std::string> arguments(extraArgs);
+    for (auto &argument : testSelection->testFramework.selectArguments(tests)) {
+      arguments.push_back(argument);
+    }
+    return runMutant(runner, mutant, arguments);
+  }
+
+  /// Most mutants are killed, so the sooner the killing test runs, the less time is spent.
+  /// The kill matrix needs every test, so then the result of the first killing test is kept.
+  std::vector<std::string> orderedTests =
+      testHistory ? testHistory->prioritize(mutant.getIdentifier(), tests, testSelection->durations)
+                  : tests;
+  ExecutionResult result;
+  bool killedBefore = false;
+  long long runningTime = 0;
+  for (auto &test : orderedTests) {
+    std::vector<std::string> arguments(extraArgs);
+    for (auto &argument : testSelection->testFramework.selectArguments({ test })) {
+      arguments.push_back(argument);
+    }
+    ExecutionResult testResult = runMutant(runner, mutant, arguments);
+    runningTime += testResult.runningTime;
+    bool killed = testResult.status != Passed;
+    if (testHistory) {
+      testHistory->recordRun(mutant.getIdentifier(), test, killed);
+    }
+    if (killMatrix) {
+      killMatrix->recordRun(mutant.getIdentifier(), test, killed);
+    }
+    if (!killedBefore) {
+      result = testResult;
+      killedBefore = killed;
+    }
+    if (killed && !killMatrix) {
+      break;
+    }
+  }
+  result.runningTime = runningTime;
+  return result;
+}
+
+ExecutionResult MutantExecutionTask::runMutant(Runner &runner, const Mutant &mutant,
+                                               const std::vector<std::string> &arguments) {
+  ExecutionResult result;
+  if (worker->runMutant(mutant.getIdentifier(), arguments, baseline.runningTime * 10, result)) {
+    return result;
+  }
+  return runner.runProgram(executable,
+                           arguments,
+                           { mutant.getIdentifier() },
+                           baseline.runningTime * 10,
+                           configuration.captureMutantOutput,
+                           std::nullopt);
+}
@@ -1,34 +1,140 @@
 #include "mull/Parallelization/Tasks/MutantPreparationTasks.h"
 #include "LLVMCompatibility.h"
 #include "mull/MutationPoint.h"
+#include "mull/Mutators/Mutator.h"
 #include "mull/Parallelization/Progress.h"
+#include "mull/Runtime/MutantResolversRuntime.h"
 #include <llvm/IR/Constant.h>
 #include <llvm/IR/Constants.h>
+#include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Instructions.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/Transforms/Utils/Cloning.h>
+#include <set>
 
 using namespace mull;
 
+CloneMutatedFunctionsTask::CloneMutatedFunctionsTask(bool mutantSchemata)
+    : mutantSchemata(mutantSchemata) {}
+
 void CloneMutatedFunctionsTask::operator()(iterator begin, iterator end, Out &storage,
                                            progress_counter &counter) {
   for (auto it = begin; it != end; it++, counter.increment()) {
     Bitcode &bitcode = **it;
-    cloneFunctions(bitcode);
+    cloneFunctions(bitcode, mutantSchemata);
+  }
+}
+
+/// Each instruction may carry only one schemata mutant, the others get their own clones
+static bool canBeInSchemata(MutationPoint *point, llvm::Function *original,
+                            std::set<llvm::Instruction *> &usedInstructions) {
+  if (!point->getMutator()->isInstructionLocal()) {
+    return false;
+  }
+  llvm::Instruction &instruction = point->getAddress().findInstruction(original);
+  if (llvm::isa<llvm::PHINode>(instruction) || instruction.isTerminator() ||
+      instruction.isEHPad()) {
+    return false;
+  }
+  return usedInstructions.insert(&instruction).second;
+}
+
+/// Turns 'instruction' into
+///
+///   %selector = load i32, i32* @mull_<function>_active_mutant
+///   br (%selector == index), %schemata_mutant, %schemata_original
+/// schemata_original:
+///   instruction
+/// schemata_mutant:
+///   mutated copy of the instruction
+/// tail:
+///   phi [ instruction, %schemata_original ], [ copy, %schemata_mutant ]
+static void insertSchemataMutant(MutationPoint *point, llvm::Instruction *instruction,
+                                 llvm::GlobalVariable *selector) {
+  llvm::LLVMContext &context = instruction->getContext();
+  llvm::BasicBlock *head = instruction->getParent();
+  llvm::Function *function = head->getParent();
+  llvm::BasicBlock *tail = head->splitBasicBlock(instruction->getIterator(), "schemata_tail");
+  llvm::BasicBlock *originalBlock =
+      llvm::BasicBlock::Create(context, "schemata_original", function, tail);
+  llvm::BasicBlock *mutantBlock =
+      llvm::BasicBlock::Create(context, "schemata_mutant", function, tail);
+
+  llvm::Instruction *mutant = instruction->clone();
+  instruction->removeFromParent();
+  originalBlock->getInstList().push_back(instruction);
+  mutantBlock->getInstList().push_back(mutant);
+  llvm::BranchInst::Create(tail, originalBlock);
+  llvm::BranchInst::Create(tail, mutantBlock);
+
+  head->getTerminator()->eraseFromParent();
+  llvm::IRBuilder<> builder(head);
+  llvm::Value *activeMutant = builder.CreateLoad(selector->getValueType(), selector);
+  llvm::Value *isMutant = builder.CreateICmpEQ(
+      activeMutant, llvm::ConstantInt::get(selector->getValueType(), point->getSchemataIndex()));
+  llvm::MDBuilder metadataBuilder(context);
+  builder.CreateCondBr(
+      isMutant, mutantBlock, originalBlock, metadataBuilder.createBranchWeights(1, 2000));
+
+  if (!instruction->getType()->isVoidTy()) {
+    llvm::PHINode *phi = llvm::PHINode::Create(instruction->getType(), 2, "", &tail->front());
+    instruction->replaceAllUsesWith(phi);
+    phi->addIncoming(instruction, originalBlock);
+    phi->addIncoming(mutant, mutantBlock);
+  }
+
+  point->applySchemataMutation(mutant);
+}
+
+static void cloneFunctionWithSchemata(llvm::Function *original,
+                                      std::vector<MutationPoint *> &points) {
+  llvm::ValueToValueMapTy map;
+  llvm::Function *mutatedFunction = llvm::CloneFunction(original, map);
+  mutatedFunction->setLinkage(llvm::GlobalValue::InternalLinkage);
+  mutatedFunction->setName("mull_" + original->getName() + "_schemata");
+
+  llvm::Type *selectorType = llvm::Type::getInt32Ty(original->getContext());
+  auto *selector = new llvm::GlobalVariable(*original->getParent(),
+                                            selectorType,
+                                            false,
+                                            llvm::GlobalValue::InternalLinkage,
+                                            llvm::ConstantInt::get(selectorType, 0),
+                                            points.front()->getSchemataSelectorName());
+
+  /// Mutation point addresses are indexes, all of them must be resolved before splitting blocks
+  std::vector<llvm::Instruction *> instructions;
+  for (MutationPoint *point : points) {
+    llvm::Instruction &instruction = point->getAddress().findInstruction(original);
+    instructions.push_back(llvm::cast<llvm::Instruction>(map[&instruction]));
+  }
+
+  for (size_t index = 0; index < points.size(); index++) {
+    points[index]->setMutantSchemata(mutatedFunction, int(index + 1));
+    insertSchemataMutant(points[index], instructions[index], selector);
   }
 }
 
-void CloneMutatedFunctionsTask::cloneFunctions(Bitcode &bitcode) {
+void CloneMutatedFunctionsTask::cloneFunctions(Bitcode &bitcode, bool mutantSchemata) {
   for (auto &pair : bitcode.getMutationPointsMap()) {
     llvm::Function *original = pair.first;
+    std::vector<MutationPoint *> schemataPoints;
+    std::set<llvm::Instruction *> schemataInstructions;
     for (MutationPoint *point : pair.second) {
       if (!point->isCovered()) {
         continue;
       }
+      if (mutantSchemata && canBeInSchemata(point, original, schemataInstructions)) {
+        schemataPoints.push_back(point);
+        continue;
+      }
       llvm::ValueToValueMapTy map;
       llvm::Function *mutatedFunction = llvm::CloneFunction(original, map);
       mutatedFunction->setLinkage(llvm::GlobalValue::InternalLinkage);
       point->setMutatedFunction(mutatedFunction);
     }
+    if (!schemataPoints.empty()) {
+      cloneFunctionWithSchemata(original, schemataPoints);
+    }
   }
 }
 
@@ -64,6 +170,18 @@ void InsertMutationTrampolinesTask::operator()(iterator begin, iterator end, Out
   }
 }
 
+static void createTrampolineCall(llvm::IRBuilder<> &builder, llvm::Function *original,
+                                 llvm::Value *callee, std::vector<llvm::Value *> &args) {
+  auto callInst = builder.CreateCall(original->getFunctionType(), callee, args);
+  callInst->setAttributes(original->getAttributes());
+  callInst->setCallingConv(original->getCallingConv());
+  if (original->getFunctionType()->getReturnType()->isVoidTy()) {
+    builder.CreateRetVoid();
+  } else {
+    builder.CreateRet(callInst);
+  }
+}
+
 void InsertMutationTrampolinesTask::insertTrampolines(Bitcode &bitcode) {
   llvm::Module *module = bitcode.getModule();
   llvm::LLVMContext &context = module->getContext();
@@ -72,6 +190,13 @@ void InsertMutationTrampolinesTask::insertTrampolines(Bitcode &bitcode) {
   llvm::FunctionType *getEnvType = llvm::FunctionType::get(charPtr, { charPtr }, false);
   llvm::Value *getenv = llvm_compat::getOrInsertFunction(module, "getenv", getEnvType);
 
+  /// The resolver queries the environment once per mutant at startup and stores the enabled
+  /// function into the trampoline. A call to a mutated function is then a single load and an
+  /// indirect call instead of a getenv() call per mutant.
+  llvm::Function *resolver = nullptr;
+  llvm::IRBuilder<> resolverBuilder(context);
+  llvm::MDBuilder metadataBuilder(context);
+
   for (auto pair : bitcode.getMutationPointsMap()) {
     bool hasCoveredMutants = false;
     for (auto point : pair.second) {
@@ -85,79 +210,71 @@ void InsertMutationTrampolinesTask::insertTrampolines(Bitcode &bitcode) {
     }
     llvm::Function *original = pair.first;
 
-    llvm::BasicBlock *entry = llvm::BasicBlock::Create(context, "entry", original);
-    llvm::BasicBlock *originalBlock = llvm::BasicBlock::Create(context, "original", original);
-    llvm::BasicBlock *trampolineCall =
-        llvm::BasicBlock::Create(context, "trampoline_call", original);
+    if (!resolver) {
+      auto resolverType = llvm::FunctionType::get(llvm::Type::getVoidTy(context), false);
+      resolver = llvm::Function::Create(resolverType,
+                                        llvm::GlobalValue::InternalLinkage,
+                                        "mull_resolve_mutants",
+                                        module);
+      resolverBuilder.SetInsertPoint(llvm::BasicBlock::Create(context, "entry", resolver));
+    }
 
     auto anyPoint = pair.second.front();
+    llvm::Function *originalCopy = module->getFunction(anyPoint->getOriginalFunctionName());
     llvm::Type *trampolineType = original->getFunctionType()->getPointerTo();
-    auto trampoline = new llvm::AllocaInst(trampolineType, 0, "trampoline", entry);
-    new llvm::StoreInst(bitcode.getModule()->getFunction(anyPoint->getOriginalFunctionName()),
-                        trampoline,
-                        originalBlock);
-    llvm::BranchInst::Create(trampolineCall, originalBlock);
-
-    llvm::BasicBlock *head = originalBlock;
+    auto *trampoline = new llvm::GlobalVariable(*module,
+                                                trampolineType,
+                                                false,
+                                                llvm::GlobalValue::InternalLinkage,
+                                                originalCopy,
+                                                original->getName() + "_trampoline");
 
+    llvm::Value *target = originalCopy;
+    llvm::Type *selectorType = llvm::Type::getInt32Ty(context);
+    llvm::Value *activeMutant = llvm::ConstantInt::get(selectorType, 0);
     for (auto &point : pair.second) {
       if (!point->isCovered()) {
         continue;
       }
-      auto name = llvm::ConstantDataArray::getString(context, point->getUserIdentifier());
-      auto *global = new llvm::GlobalVariable(
-          *module, name->getType(), true, llvm::GlobalValue::PrivateLinkage, name);
-
-      llvm::BasicBlock *mutationCheckBlock =
-          llvm::BasicBlock::Create(context, point->getUserIdentifier() + "_check", original);
-      llvm::Value *nullPtr = llvm::Constant::getNullValue(charPtr);
-      llvm::CmpInst *predicate = llvm::CmpInst::Create(llvm::Instruction::ICmp,
-                                                       llvm::ICmpInst::ICMP_NE,
-                                                       nullPtr,
-                                                       nullPtr,
-                                                       "is_enabled",
-                                                       mutationCheckBlock);
-      llvm::Value *zero = llvm::Constant::getNullValue(llvm::Type::getInt64Ty(context));
-      auto mutantName =
-          llvm::ConstantExpr::getInBoundsGetElementPtr(name->getType(), global, { zero, zero });
-      auto getEnvCall =
-          llvm::CallInst::Create(getEnvType, getenv, { mutantName }, "check_mutation", predicate);
-      predicate->setOperand(0, getEnvCall);
-
-      llvm::BasicBlock *mutationBlock =
-          llvm::BasicBlock::Create(context, point->getUserIdentifier(), original);
-      new llvm::StoreInst(point->getMutatedFunction(), trampoline, mutationBlock);
-
-      llvm::BranchInst::Create(mutationBlock, head, predicate, mutationCheckBlock);
-      llvm::BranchInst::Create(trampolineCall, mutationBlock);
-      head = mutationCheckBlock;
+      llvm::Value *mutantName = resolverBuilder.CreateGlobalStringPtr(point->getUserIdentifier());
+      llvm::Value *getEnvCall =
+          resolverBuilder.CreateCall(getEnvType, getenv, { mutantName }, "check_mutation");
+      llvm::Value *enabled = resolverBuilder.CreateIsNotNull(getEnvCall, "is_enabled");
+      target = resolverBuilder.CreateSelect(enabled, point->getMutatedFunction(), target);
+      if (point->getSchemataIndex() != 0) {
+        activeMutant = resolverBuilder.CreateSelect(
+            enabled, llvm::ConstantInt::get(selectorType, point->getSchemataIndex()), activeMutant);
+      }
+    }
+    resolverBuilder.CreateStore(target, trampoline);
+    if (auto selector = module->getNamedGlobal(anyPoint->getSchemataSelectorName())) {
+      resolverBuilder.CreateStore(activeMutant, selector);
     }
 
-    llvm::BranchInst::Create(head, entry);
+    llvm::BasicBlock *entry = llvm::BasicBlock::Create(context, "entry", original);
+    llvm::BasicBlock *originalBlock = llvm::BasicBlock::Create(context, "original", original);
+    llvm::BasicBlock *mutantBlock = llvm::BasicBlock::Create(context, "mutant", original);
+
+    llvm::IRBuilder<> builder(entry);
+    llvm::Value *loadValue = builder.CreateLoad(trampolineType, trampoline, "trampoline_pointer");
+    llvm::Value *isOriginal = builder.CreateICmpEQ(loadValue, originalCopy, "is_original");
+    /// Mutants are rare compared to the original code, keep the original path hot
+    builder.CreateCondBr(
+        isOriginal, originalBlock, mutantBlock, metadataBuilder.createBranchWeights(2000, 1));
 
     std::vector<llvm::Value *> args;
     for (auto &arg : original->args()) {
       args.push_back(&arg);
     }
 
-    auto retType = original->getFunctionType()->getReturnType();
-    llvm::Constant *dummy = nullptr;
-    if (!retType->isVoidTy()) {
-      dummy = llvm::Constant::getNullValue(retType);
-    }
+    builder.SetInsertPoint(originalBlock);
+    createTrampolineCall(builder, original, originalCopy, args);
+    builder.SetInsertPoint(mutantBlock);
+    createTrampolineCall(builder, original, loadValue, args);
+  }
 
-    auto retVal = llvm::ReturnInst::Create(context, dummy, trampolineCall);
-    auto loadValue = new llvm::LoadInst(trampoline->getType()->getPointerElementType(),
-                                        trampoline,
-                                        "trampoline_pointer",
-                                        false,
-                                        retVal);
-    auto callInst =
-        llvm::CallInst::Create(original->getFunctionType(), loadValue, args, "", retVal);
-    callInst->setAttributes(original->getAttributes());
-    callInst->setCallingConv(original->getCallingConv());
-    if (!retType->isVoidTy()) {
-      retVal->setOperand(0, callInst);
-    }
+  if (resolver) {
+    resolverBuilder.CreateRetVoid();
+    registerMutantResolver(*module, resolver);
   }
 }
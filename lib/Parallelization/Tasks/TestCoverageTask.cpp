@@ -0,0 +1,63 @@
+#include "mull/Parallelization/Tasks/TestCoverageTask.h"
+
+#include "mull/Config/Configuration.h"
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Parallelization/Progress.h"
+#include "mull/Runtime/TestCoverageRuntime.h"
+#include "mull/Toolchain/Runner.h"
+#include "mull/Toolchain/TestFramework.h"
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Process.h>
+
+using namespace mull;
+
+TestCoverageTask::TestCoverageTask(const Configuration &configuration, Diagnostics &diagnostics,
+                                   const std::string &executable,
+                                   const std::vector<std::string> &extraArgs,
+                                   const TestFramework &testFramework)
+    : configuration(configuration), diagnostics(diagnostics), executable(executable),
+      extraArgs(extraArgs), testFramework(testFramework) {}
+
+void TestCoverageTask::operator()(iterator begin, iterator end, Out &storage,
+                                  progress_counter &counter) {
+  Runner runner(diagnostics);
+  for (auto it = begin; it != end; ++it, counter.increment()) {
+    std::vector<std::string> arguments(extraArgs);
+    for (auto &argument : testFramework.selectArguments({ *it })) {
+      arguments.push_back(argument);
+    }
+    TestCoverage coverage;
+    coverage.test = *it;
+    /// The probes append to the file, but never create it
+    llvm::SmallString<128> coveragePath;
+    int descriptor;
+    if (auto error = llvm::sys::fs::createTemporaryFile(
+            "mull-coverage", "txt", descriptor, coveragePath)) {
+      diagnostics.warning("Cannot create test coverage file: " + error.message());
+      storage.push_back(std::move(coverage));
+      continue;
+    }
+    llvm::sys::Process::SafelyCloseFileDescriptor(descriptor);
+    std::vector<std::pair<std::string, std::string>> environment{
+      { TestCoverageEnvironmentVariable, coveragePath.str().str() }
+    };
+    coverage.result = runner.runProgram(executable,
+                                        arguments,
+                                        {},
+                                        configuration.timeout,
+                                        configuration.captureTestOutput,
+                                        std::nullopt,
+                                        environment);
+    auto buffer = llvm::MemoryBuffer::getFile(coveragePath);
+    llvm::sys::fs::remove(coveragePath);
+    if (!buffer) {
+      diagnostics.warning("Cannot read test coverage: " + buffer.getError().message());
+    } else {
+      coverage.coverageKnown =
+          parseTestCoverage(buffer.get()->getBuffer().str(), coverage.mutants);
+    }
+    storage.push_back(std::move(coverage));
+  }
+}
@@ -0,0 +1,55 @@
+#include "mull/Parallelization/ThreadPool.h"
+
+#include <algorithm>
+
+using namespace mull;
+
+ThreadPool::ThreadPool(size_t threadsCount) : stopping(false) {
+  threadsCount = std::max(threadsCount, size_t(1));
+  threads.reserve(threadsCount);
+  for (size_t i = 0; i < threadsCount; i++) {
+    threads.emplace_back(&ThreadPool::work, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  condition.notify_all();
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+std::future<void> ThreadPool::submit(std::function<void()> job) {
+  std::packaged_task<void()> task(std::move(job));
+  std::future<void> future = task.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    jobs.push(std::move(task));
+  }
+  condition.notify_one();
+  return future;
+}
+
+size_t ThreadPool::size() const {
+  return threads.size();
+}
+
+void ThreadPool::work() {
+  while (true) {
+    std::packaged_task<void()> job;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait(lock, [this]() { return stopping || !jobs.empty(); });
+      if (jobs.empty()) {
+        return;
+      }
+      job = std::move(jobs.front());
+      jobs.pop();
+    }
+    job();
+  }
+}
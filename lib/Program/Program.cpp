@@ -12,6 +12,20 @@ Program::Program(std::vector<std::unique_ptr<Bitcode>> bitcode) {
   }
 }
 
+Program Program::fromBitcodeBuffers(std::vector<llvm::MemoryBufferRef> bitcodeBuffers) {
+  Program program({});
+  program._bitcodeBuffers = std::move(bitcodeBuffers);
+  return program;
+}
+
 std::vector<std::unique_ptr<Bitcode>> &Program::bitcode() {
   return _bitcode;
 }
+
+const std::vector<llvm::MemoryBufferRef> &Program::bitcodeBuffers() const {
+  return _bitcodeBuffers;
+}
+
+bool Program::isStreaming() const {
+  return !_bitcodeBuffers.empty();
+}
@@ -45,7 +45,9 @@ static void printMutant(Diagnostics &diagnostics, MutatorsFactory &factory,
 
 static void printMutants(Diagnostics &diagnostics, MutatorsFactory &factory,
                          SourceCodeReader &reader, const std::vector<Mutant *> &mutants,
-                         size_t totalSize, const std::string &status) {
+                         const std::set<Mutant *> &cachedMutants,
+                         const std::set<Mutant *> &inferredMutants, size_t totalSize,
+                         const std::string &status) {
   if (mutants.empty()) {
     return;
   }
@@ -53,7 +55,14 @@ static void printMutants(Diagnostics &diagnostics, MutatorsFactory &factory,
   stringstream << status << " mutants (" << mutants.size() << "/" << totalSize << "):";
   diagnostics.info(stringstream.str());
   for (auto mutant : mutants) {
-    printMutant(diagnostics, factory, reader, *mutant, status);
+    std::string mutantStatus = status;
+    if (cachedMutants.count(mutant) != 0) {
+      mutantStatus += " (cached)";
+    }
+    if (inferredMutants.count(mutant) != 0) {
+      mutantStatus += " (inferred)";
+    }
+    printMutant(diagnostics, factory, reader, *mutant, mutantStatus);
   }
 }
 
@@ -69,10 +78,18 @@ void IDEReporter::reportResults(const Result &result) {
   std::vector<Mutant *> killedMutants;
   std::vector<Mutant *> survivedMutants;
   std::vector<Mutant *> notCoveredMutants;
+  std::set<Mutant *> cachedMutants;
+  std::set<Mutant *> inferredMutants;
   for (auto &mutationResult : result.getMutationResults()) {
     auto mutant = mutationResult->getMutant();
     auto &executionResult = mutationResult->getExecutionResult();
 
+    if (executionResult.source == StatusSource::Cached) {
+      cachedMutants.insert(mutant);
+    }
+    if (executionResult.source == StatusSource::Inferred) {
+      inferredMutants.insert(mutant);
+    }
     if (mutantSurvived(executionResult.status)) {
       survivedMutants.push_back(mutant);
     } else if (mutantNotCovered(executionResult.status)) {
@@ -93,6 +110,8 @@ void IDEReporter::reportResults(const Result &result) {
                  factory,
                  sourceCodeReader,
                  killedMutants,
+                 cachedMutants,
+                 inferredMutants,
                  result.getMutants().size(),
                  "Killed");
   }
@@ -101,15 +120,31 @@ void IDEReporter::reportResults(const Result &result) {
                factory,
                sourceCodeReader,
                survivedMutants,
+               cachedMutants,
+               inferredMutants,
                result.getMutants().size(),
                "Survived");
   printMutants(diagnostics,
                factory,
                sourceCodeReader,
                notCoveredMutants,
+               cachedMutants,
+               inferredMutants,
                result.getMutants().size(),
                "Not Covered");
 
+  if (!cachedMutants.empty()) {
+    std::stringstream stringstream;
+    stringstream << "Cached results: " << cachedMutants.size() << "/" << result.getMutants().size();
+    diagnostics.info(stringstream.str());
+  }
+  if (!inferredMutants.empty()) {
+    std::stringstream stringstream;
+    stringstream << "Inferred results: " << inferredMutants.size() << "/"
+                 << result.getMutants().size();
+    diagnostics.info(stringstream.str());
+  }
+
   if (survivedMutants.empty() && notCoveredMutants.empty()) {
     diagnostics.info("All mutations have been killed");
   }
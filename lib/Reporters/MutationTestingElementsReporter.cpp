@@ -27,7 +27,9 @@ static bool mutantSurvived(const ExecutionStatus &status) {
 
 static json11::Json createFiles(Diagnostics &diagnostics, const Result &result,
                                 const std::set<Mutant *> &killedMutants,
-                                const std::set<Mutant *> &notCoveredMutants) {
+                                const std::set<Mutant *> &notCoveredMutants,
+                                const std::set<Mutant *> &cachedMutants,
+                                const std::set<Mutant *> &inferredMutants) {
   SourceManager sourceManager;
 
   Json::object filesJSON;
@@ -76,7 +78,7 @@ static json11::Json createFiles(Diagnostics &diagnostics, const Result &result,
 
       auto mutator = factory.getMutator(mutant->getMutatorIdentifier());
 
-      Json mpJson = Json::object{
+      Json::object mpJson{
         { "id", mutant->getMutatorIdentifier() },
         { "mutatorName", mutator->getDiagnostics() },
         { "replacement", mutator->getReplacement() },
@@ -86,6 +88,12 @@ static json11::Json createFiles(Diagnostics &diagnostics, const Result &result,
               { "end", Json::object{ { "line", endLine }, { "column", endColumn } } } } },
         { "status", status }
       };
+      if (cachedMutants.count(mutant) != 0) {
+        mpJson["statusReason"] = "Cached result of a previous run";
+      }
+      if (inferredMutants.count(mutant) != 0) {
+        mpJson["statusReason"] = "Inferred from a mutant that subsumes this one";
+      }
       mutantsEntries.push_back(mpJson);
     }
 
@@ -130,10 +138,18 @@ void MutationTestingElementsReporter::reportResults(const Result &result) {
 
   std::set<Mutant *> killedMutants;
   std::set<Mutant *> notCoveredMutants;
+  std::set<Mutant *> cachedMutants;
+  std::set<Mutant *> inferredMutants;
   for (auto &mutationResult : result.getMutationResults()) {
     auto mutant = mutationResult->getMutant();
     auto &executionResult = mutationResult->getExecutionResult();
 
+    if (executionResult.source == StatusSource::Cached) {
+      cachedMutants.insert(mutant);
+    }
+    if (executionResult.source == StatusSource::Inferred) {
+      inferredMutants.insert(mutant);
+    }
     if (executionResult.status == NotCovered) {
       notCoveredMutants.insert(mutant);
     } else if (!mutantSurvived(executionResult.status)) {
@@ -148,7 +164,8 @@ void MutationTestingElementsReporter::reportResults(const Result &result) {
     { "mutationScore", (int)score },
     { "thresholds", Json::object{ { "high", 80 }, { "low", 60 } } },
     { "files",
-      createFiles(diagnostics, result, killedMutants, notCoveredMutants) },
+      createFiles(
+          diagnostics, result, killedMutants, notCoveredMutants, cachedMutants, inferredMutants) },
     { "schemaVersion", "1.1.1" },
   };
   std::string json_str = json.dump();
@@ -81,7 +81,7 @@ void mull::SQLiteReporter::reportResults(const Result &result) {
   sqlite_exec(diagnostics, database, "BEGIN TRANSACTION");
 
   const char *insertExecutionResultQuery =
-      "INSERT INTO execution_result VALUES (?1, ?2, ?3, ?4, ?5)";
+      "INSERT INTO execution_result VALUES (?1, ?2, ?3, ?4, ?5, ?6)";
   sqlite3_stmt *insertExecutionResultStmt;
   sqlite3_prepare(database, insertExecutionResultQuery, -1, &insertExecutionResultStmt, nullptr);
 
@@ -107,6 +107,9 @@ void mull::SQLiteReporter::reportResults(const Result &result) {
                       mutationExecutionResult.stderrOutput.c_str(),
                       -1,
                       SQLITE_TRANSIENT);
+    sqlite3_bind_int(insertExecutionResultStmt,
+                     executionResultIndex++,
+                     static_cast<int>(mutationExecutionResult.source));
 
     sqlite3_step(insertExecutionResultStmt);
     sqlite3_clear_bindings(insertExecutionResultStmt);
@@ -152,7 +155,8 @@ CREATE TABLE execution_result (
   status INT,
   duration INT,
   stdout TEXT,
-  stderr TEXT
+  stderr TEXT,
+  status_source INT
 );
 
 CREATE TABLE mutant (
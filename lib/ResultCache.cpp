@@ -0,0 +1,337 @@
+#include "mull/ResultCache.h"
+
+#include "mull/Bitcode.h"
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Hashing.h"
+#include "mull/Mutant.h"
+#include "mull/MutationPoint.h"
+#include "mull/SQLiteUtils.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/IntrinsicInst.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Operator.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <set>
+#include <sqlite3.h>
+#include <unordered_set>
+
+using namespace mull;
+
+static const char *CreateTables = R"CreateTables(
+CREATE TABLE IF NOT EXISTS mutant_result (
+  mutant TEXT PRIMARY KEY,
+  code_hash TEXT,
+  program_hash TEXT,
+  status INT,
+  duration INT
+);
+)CreateTables";
+
+static const char *Description = "result cache";
+
+static void hashPrintable(llvm::MD5 &hash, const llvm::Type *type) {
+  std::string text;
+  llvm::raw_string_ostream stream(text);
+  type->print(stream);
+  hash.update(stream.str());
+}
+
+/// Local values are hashed by their position, and the globals by their names,
+/// so that the hash does not depend on the rest of the module
+static void hashOperand(llvm::MD5 &hash, const llvm::Value *value,
+                        const std::unordered_map<const llvm::Value *, size_t> &locals) {
+  auto local = locals.find(value);
+  if (local != locals.end()) {
+    hash.update("%" + std::to_string(local->second));
+  } else if (auto global = llvm::dyn_cast<llvm::GlobalValue>(value)) {
+    hash.update("@");
+    hash.update(global->getName());
+  } else if (llvm::isa<llvm::MetadataAsValue>(value)) {
+    hash.update("!");
+  } else {
+    std::string text;
+    llvm::raw_string_ostream stream(text);
+    value->print(stream);
+    hash.update(stream.str());
+  }
+}
+
+/// A structural hash: unlike the printed IR, it does not change when an unrelated part of
+/// the module changes (e.g. the numbering of the debug metadata)
+static std::string hashFunction(const llvm::Function &function) {
+  std::unordered_map<const llvm::Value *, size_t> locals;
+  for (auto &argument : function.args()) {
+    locals.emplace(&argument, locals.size());
+  }
+  for (auto &basicBlock : function) {
+    locals.emplace(&basicBlock, locals.size());
+    for (auto &instruction : basicBlock) {
+      locals.emplace(&instruction, locals.size());
+    }
+  }
+
+  llvm::MD5 hash;
+  hashPrintable(hash, function.getFunctionType());
+  for (auto &basicBlock : function) {
+    hash.update("{");
+    for (auto &instruction : basicBlock) {
+      if (llvm::isa<llvm::DbgInfoIntrinsic>(instruction)) {
+        continue;
+      }
+      hash.update(instruction.getOpcodeName());
+      hashPrintable(hash, instruction.getType());
+      if (auto compare = llvm::dyn_cast<llvm::CmpInst>(&instruction)) {
+        hash.update(std::to_string(compare->getPredicate()));
+      }
+      if (llvm::isa<llvm::OverflowingBinaryOperator>(instruction)) {
+        hash.update(instruction.hasNoSignedWrap() ? "nsw" : "");
+        hash.update(instruction.hasNoUnsignedWrap() ? "nuw" : "");
+      }
+      if (llvm::isa<llvm::PossiblyExactOperator>(instruction)) {
+        hash.update(instruction.isExact() ? "exact" : "");
+      }
+      if (llvm::isa<llvm::FPMathOperator>(instruction)) {
+        hash.update(instruction.isFast() ? "fast" : "");
+      }
+      if (auto load = llvm::dyn_cast<llvm::LoadInst>(&instruction)) {
+        hash.update(load->isVolatile() ? "volatile" : "");
+      }
+      if (auto store = llvm::dyn_cast<llvm::StoreInst>(&instruction)) {
+        hash.update(store->isVolatile() ? "volatile" : "");
+      }
+      if (auto alloca = llvm::dyn_cast<llvm::AllocaInst>(&instruction)) {
+        hashPrintable(hash, alloca->getAllocatedType());
+      }
+      if (auto gep = llvm::dyn_cast<llvm::GetElementPtrInst>(&instruction)) {
+        hashPrintable(hash, gep->getSourceElementType());
+        hash.update(gep->isInBounds() ? "inbounds" : "");
+      }
+      if (auto phi = llvm::dyn_cast<llvm::PHINode>(&instruction)) {
+        for (auto block : phi->blocks()) {
+          hashOperand(hash, block, locals);
+        }
+      }
+      for (auto &operand : instruction.operands()) {
+        hashOperand(hash, operand.get(), locals);
+      }
+      hash.update(";");
+    }
+    hash.update("}");
+  }
+  return hexDigest(hash);
+}
+
+static std::string hashGlobal(const llvm::GlobalVariable &global) {
+  llvm::MD5 hash;
+  hashPrintable(hash, global.getValueType());
+  hash.update(global.isConstant() ? "constant" : "global");
+  std::string text;
+  llvm::raw_string_ostream stream(text);
+  global.getInitializer()->print(stream);
+  hash.update(stream.str());
+  return hexDigest(hash);
+}
+
+/// The callees are found by name, so that the calls to the other modules of the same batch are
+/// followed as well
+static std::string
+hashWithCallees(const llvm::Function *function,
+                const std::unordered_map<std::string, const llvm::Function *> &definitions,
+                const std::unordered_map<const llvm::Function *, std::string> &hashes) {
+  std::set<std::string> reachable;
+  std::vector<const llvm::Function *> worklist({ function });
+  std::unordered_set<const llvm::Function *> visited({ function });
+  while (!worklist.empty()) {
+    const llvm::Function *current = worklist.back();
+    worklist.pop_back();
+    reachable.insert(current->getName().str() + ":" + hashes.at(current));
+    for (auto &instruction : llvm::instructions(current)) {
+      for (auto &operand : instruction.operands()) {
+        auto callee = llvm::dyn_cast<llvm::Function>(operand.get()->stripPointerCasts());
+        if (!callee) {
+          continue;
+        }
+        auto definition = definitions.find(callee->getName().str());
+        if (definition == definitions.end()) {
+          reachable.insert(callee->getName().str());
+        } else if (visited.insert(definition->second).second) {
+          worklist.push_back(definition->second);
+        }
+      }
+    }
+  }
+  llvm::MD5 hash;
+  for (auto &entry : reachable) {
+    hash.update(entry);
+    hash.update(";");
+  }
+  return hexDigest(hash);
+}
+
+ResultCache::ResultCache(Diagnostics &diagnostics, std::string databasePath)
+    : diagnostics(diagnostics), databasePath(std::move(databasePath)) {}
+
+const std::string &ResultCache::getDatabasePath() const {
+  return databasePath;
+}
+
+void ResultCache::load() {
+  if (!llvm::sys::fs::exists(databasePath)) {
+    return;
+  }
+  sqlite3 *database = sqlite::openDatabase(diagnostics, databasePath, CreateTables, Description);
+  if (!database) {
+    return;
+  }
+  sqlite3_stmt *statement = nullptr;
+  sqlite3_prepare_v2(database,
+                     "SELECT mutant, code_hash, program_hash, status, duration FROM mutant_result",
+                     -1,
+                     &statement,
+                     nullptr);
+  while (sqlite3_step(statement) == SQLITE_ROW) {
+    Entry entry;
+    entry.codeHash = sqlite::columnText(statement, 1);
+    entry.programHash = sqlite::columnText(statement, 2);
+    entry.status = ExecutionStatus(sqlite3_column_int(statement, 3));
+    entry.runningTime = sqlite3_column_int64(statement, 4);
+    entries[sqlite::columnText(statement, 0)] = entry;
+  }
+  sqlite3_finalize(statement);
+  sqlite3_close(database);
+}
+
+void ResultCache::save() {
+  if (newEntries.empty()) {
+    return;
+  }
+  llvm::sys::fs::create_directories(llvm::sys::path::parent_path(databasePath), true);
+  sqlite3 *database = sqlite::openDatabase(diagnostics, databasePath, CreateTables, Description);
+  if (!database) {
+    return;
+  }
+  sqlite::execute(diagnostics, database, "BEGIN TRANSACTION", Description);
+  sqlite3_stmt *statement = nullptr;
+  sqlite3_prepare_v2(database,
+                     "INSERT OR REPLACE INTO mutant_result VALUES (?1, ?2, ?3, ?4, ?5)",
+                     -1,
+                     &statement,
+                     nullptr);
+  for (auto &pair : newEntries) {
+    sqlite3_bind_text(statement, 1, pair.first.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(statement, 2, pair.second.codeHash.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(statement, 3, pair.second.programHash.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(statement, 4, pair.second.status);
+    sqlite3_bind_int64(statement, 5, pair.second.runningTime);
+    sqlite3_step(statement);
+    sqlite3_clear_bindings(statement);
+    sqlite3_reset(statement);
+  }
+  sqlite3_finalize(statement);
+  sqlite::execute(diagnostics, database, "END TRANSACTION", Description);
+  sqlite3_close(database);
+  newEntries.clear();
+}
+
+/// The tests may reach a mutated function from anywhere, e.g. through its callers, so every
+/// function is a part of the program hash, the mutated ones included
+void ResultCache::hashProgram(const std::vector<std::unique_ptr<Bitcode>> &bitcode,
+                              const std::vector<MutationPoint *> &mutationPoints) {
+  std::unordered_map<std::string, const llvm::Function *> definitions;
+  std::unordered_map<const llvm::Function *, std::string> hashes;
+  for (auto &module : bitcode) {
+    for (auto &function : *module->getModule()) {
+      if (function.isDeclaration()) {
+        continue;
+      }
+      std::string hash = hashFunction(function);
+      hashes[&function] = hash;
+      definitions.emplace(function.getName().str(), &function);
+      programCodeHashes.push_back(function.getName().str() + ":" + hash);
+    }
+    for (auto &global : module->getModule()->globals()) {
+      if (global.hasInitializer()) {
+        programCodeHashes.push_back(global.getName().str() + ":" + hashGlobal(global));
+      }
+    }
+  }
+
+  std::unordered_map<const llvm::Function *, std::string> codeHashes;
+  for (MutationPoint *point : mutationPoints) {
+    const llvm::Function *function = point->getOriginalFunction();
+    auto codeHash = codeHashes.find(function);
+    if (codeHash == codeHashes.end()) {
+      codeHash =
+          codeHashes.emplace(function, hashWithCallees(function, definitions, hashes)).first;
+    }
+    mutantCodeHashes[point->getUserIdentifier()].push_back(codeHash->second);
+  }
+  combinedProgramHash.clear();
+}
+
+std::string ResultCache::codeHash(const std::string &mutant) const {
+  auto hashes = mutantCodeHashes.find(mutant);
+  if (hashes == mutantCodeHashes.end()) {
+    return std::string();
+  }
+  std::vector<std::string> sortedHashes(hashes->second);
+  std::sort(sortedHashes.begin(), sortedHashes.end());
+  llvm::MD5 hash;
+  for (auto &entry : sortedHashes) {
+    hash.update(entry);
+  }
+  return hexDigest(hash);
+}
+
+/// The batches of modules may come in any order, the hash must not depend on it
+const std::string &ResultCache::programHash() {
+  if (combinedProgramHash.empty()) {
+    std::vector<std::string> sortedHashes(programCodeHashes);
+    std::sort(sortedHashes.begin(), sortedHashes.end());
+    llvm::MD5 hash;
+    for (auto &entry : sortedHashes) {
+      hash.update(entry);
+      hash.update(";");
+    }
+    combinedProgramHash = hexDigest(hash);
+  }
+  return combinedProgramHash;
+}
+
+bool ResultCache::lookup(const Mutant &mutant, ExecutionResult &result) {
+  auto entry = entries.find(mutant.getIdentifier());
+  if (entry == entries.end() || entry->second.programHash != programHash() ||
+      entry->second.codeHash != codeHash(mutant.getIdentifier())) {
+    return false;
+  }
+  result.status = entry->second.status;
+  result.runningTime = entry->second.runningTime;
+  result.source = StatusSource::Cached;
+  return true;
+}
+
+long long ResultCache::previousRunningTime(const Mutant &mutant) const {
+  auto entry = entries.find(mutant.getIdentifier());
+  if (entry == entries.end()) {
+    return -1;
+  }
+  return entry->second.runningTime;
+}
+
+void ResultCache::store(const Mutant &mutant, const ExecutionResult &result) {
+  std::string hash = codeHash(mutant.getIdentifier());
+  /// Not covered and dry run mutants did not run, their status tells nothing about the tests
+  if (hash.empty() || result.source != StatusSource::Executed || result.status == NotCovered ||
+      result.status == DryRun || result.status == Invalid) {
+    return;
+  }
+  newEntries[mutant.getIdentifier()] =
+      Entry{ hash, programHash(), result.status, result.runningTime };
+}
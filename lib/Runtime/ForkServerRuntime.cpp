@@ -0,0 +1,157 @@
+#include "mull/Runtime/ForkServerRuntime.h"
+#include "mull/Runtime/MutantResolversRuntime.h"
+
+#include "LLVMCompatibility.h"
+
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Transforms/Utils/ModuleUtils.h>
+
+using namespace llvm;
+
+const char *mull::ForkServerEnvironmentVariable = "MULL_FORK_SERVER";
+
+void mull::insertForkServer(llvm::Module &module) {
+  LLVMContext &context = module.getContext();
+  Type *voidType = Type::getVoidTy(context);
+  Type *intType = Type::getInt32Ty(context);
+  Type *sizeType = module.getDataLayout().getIntPtrType(context);
+  Type *charPtr = Type::getInt8Ty(context)->getPointerTo();
+  Type *intPtr = intType->getPointerTo();
+
+  FunctionType *getenvType = FunctionType::get(charPtr, { charPtr }, false);
+  FunctionType *readWriteType = FunctionType::get(sizeType, { intType, charPtr, sizeType }, false);
+  FunctionType *forkType = FunctionType::get(intType, false);
+  FunctionType *waitpidType = FunctionType::get(intType, { intType, intPtr, intType }, false);
+  FunctionType *closeType = FunctionType::get(intType, { intType }, false);
+  FunctionType *exitType = FunctionType::get(voidType, { intType }, false);
+  FunctionType *setenvType = FunctionType::get(intType, { charPtr, charPtr, intType }, false);
+  FunctionType *unsetenvType = FunctionType::get(intType, { charPtr }, false);
+
+  Value *getenvFunction = llvm_compat::getOrInsertFunction(&module, "getenv", getenvType);
+  Value *readFunction = llvm_compat::getOrInsertFunction(&module, "read", readWriteType);
+  Value *writeFunction = llvm_compat::getOrInsertFunction(&module, "write", readWriteType);
+  Value *forkFunction = llvm_compat::getOrInsertFunction(&module, "fork", forkType);
+  Value *waitpidFunction = llvm_compat::getOrInsertFunction(&module, "waitpid", waitpidType);
+  Value *closeFunction = llvm_compat::getOrInsertFunction(&module, "close", closeType);
+  Value *exitFunction = llvm_compat::getOrInsertFunction(&module, "_exit", exitType);
+  Value *setenvFunction = llvm_compat::getOrInsertFunction(&module, "setenv", setenvType);
+  Value *unsetenvFunction = llvm_compat::getOrInsertFunction(&module, "unsetenv", unsetenvType);
+
+  Function *resolveAllMutants = insertResolveAllMutants(module);
+
+  Function *server = Function::Create(FunctionType::get(voidType, false),
+                                      GlobalValue::InternalLinkage,
+                                      "mull_fork_server",
+                                      &module);
+
+  BasicBlock *entry = BasicBlock::Create(context, "entry", server);
+  BasicBlock *handshake = BasicBlock::Create(context, "handshake", server);
+  BasicBlock *loop = BasicBlock::Create(context, "loop", server);
+  BasicBlock *checkLength = BasicBlock::Create(context, "check_length", server);
+  BasicBlock *readIdentifier = BasicBlock::Create(context, "read_identifier", server);
+  BasicBlock *forkChild = BasicBlock::Create(context, "fork_child", server);
+  BasicBlock *dispatch = BasicBlock::Create(context, "dispatch", server);
+  BasicBlock *child = BasicBlock::Create(context, "child", server);
+  BasicBlock *parent = BasicBlock::Create(context, "parent", server);
+  BasicBlock *report = BasicBlock::Create(context, "report", server);
+  BasicBlock *finish = BasicBlock::Create(context, "finish", server);
+  BasicBlock *fail = BasicBlock::Create(context, "fail", server);
+  BasicBlock *done = BasicBlock::Create(context, "done", server);
+
+  Constant *controlFd = ConstantInt::get(intType, ForkServerControlDescriptor);
+  Constant *statusFd = ConstantInt::get(intType, ForkServerStatusDescriptor);
+  Constant *intSize = ConstantInt::get(sizeType, sizeof(int32_t));
+
+  IRBuilder<> builder(entry);
+  Type *identifierType = ArrayType::get(Type::getInt8Ty(context), ForkServerMaxIdentifierLength);
+  Value *identifier = builder.CreateAlloca(identifierType, nullptr, "identifier");
+  Value *length = builder.CreateAlloca(intType, nullptr, "length");
+  Value *pid = builder.CreateAlloca(intType, nullptr, "pid");
+  Value *status = builder.CreateAlloca(intType, nullptr, "status");
+  Value *hello = builder.CreateAlloca(intType, nullptr, "hello");
+  Value *identifierPtr = builder.CreateBitCast(identifier, charPtr);
+  Value *environmentVariable =
+      builder.CreateGlobalStringPtr(ForkServerEnvironmentVariable, "mull_fork_server_env");
+  Value *enabled = builder.CreateCall(getenvType, getenvFunction, { environmentVariable });
+  builder.CreateCondBr(builder.CreateIsNull(enabled), done, handshake);
+
+  /// No one is listening on the other side: run the program as usual
+  builder.SetInsertPoint(handshake);
+  builder.CreateStore(ConstantInt::get(intType, ForkServerHello), hello);
+  Value *helloWritten = builder.CreateCall(
+      readWriteType, writeFunction, { statusFd, builder.CreateBitCast(hello, charPtr), intSize });
+  builder.CreateCondBr(builder.CreateICmpNE(helloWritten, intSize), done, loop);
+
+  /// Mull closes the control pipe once all the mutants are executed
+  builder.SetInsertPoint(loop);
+  Value *lengthRead = builder.CreateCall(
+      readWriteType, readFunction, { controlFd, builder.CreateBitCast(length, charPtr), intSize });
+  builder.CreateCondBr(builder.CreateICmpNE(lengthRead, intSize), finish, checkLength);
+
+  builder.SetInsertPoint(checkLength);
+  Value *identifierLength = builder.CreateLoad(intType, length);
+  Value *validLength = builder.CreateAnd(
+      builder.CreateICmpSGT(identifierLength, ConstantInt::get(intType, 0)),
+      builder.CreateICmpSLT(identifierLength,
+                            ConstantInt::get(intType, ForkServerMaxIdentifierLength)));
+  builder.CreateCondBr(validLength, readIdentifier, fail);
+
+  builder.SetInsertPoint(readIdentifier);
+  Value *identifierSize = builder.CreateZExt(identifierLength, sizeType);
+  Value *identifierRead = builder.CreateCall(
+      readWriteType, readFunction, { controlFd, identifierPtr, identifierSize });
+  builder.CreateCondBr(builder.CreateICmpNE(identifierRead, identifierSize), fail, forkChild);
+
+  builder.SetInsertPoint(forkChild);
+  Value *terminator =
+      builder.CreateInBoundsGEP(Type::getInt8Ty(context), identifierPtr, identifierSize);
+  builder.CreateStore(ConstantInt::get(Type::getInt8Ty(context), 0), terminator);
+  Value *childPid = builder.CreateCall(forkType, forkFunction, {});
+  builder.CreateCondBr(
+      builder.CreateICmpSLT(childPid, ConstantInt::get(intType, 0)), fail, dispatch);
+
+  builder.SetInsertPoint(dispatch);
+  builder.CreateCondBr(builder.CreateIsNull(childPid), child, parent);
+
+  /// The child enables the mutant and proceeds with the normal program execution
+  builder.SetInsertPoint(child);
+  builder.CreateCall(closeType, closeFunction, { controlFd });
+  builder.CreateCall(closeType, closeFunction, { statusFd });
+  builder.CreateCall(unsetenvType, unsetenvFunction, { environmentVariable });
+  builder.CreateCall(setenvType,
+                     setenvFunction,
+                     { identifierPtr,
+                       builder.CreateGlobalStringPtr("1", "mull_fork_server_enabled"),
+                       ConstantInt::get(intType, 1) });
+  /// The mutants were resolved before the fork, the trampolines must see the new environment
+  builder.CreateCall(resolveAllMutants->getFunctionType(), resolveAllMutants, {});
+  builder.CreateRetVoid();
+
+  builder.SetInsertPoint(parent);
+  builder.CreateStore(childPid, pid);
+  builder.CreateCall(
+      readWriteType, writeFunction, { statusFd, builder.CreateBitCast(pid, charPtr), intSize });
+  Value *waited = builder.CreateCall(
+      waitpidType, waitpidFunction, { childPid, status, ConstantInt::get(intType, 0) });
+  builder.CreateCondBr(builder.CreateICmpSLT(waited, ConstantInt::get(intType, 0)), fail, report);
+
+  builder.SetInsertPoint(report);
+  builder.CreateCall(
+      readWriteType, writeFunction, { statusFd, builder.CreateBitCast(status, charPtr), intSize });
+  builder.CreateBr(loop);
+
+  builder.SetInsertPoint(finish);
+  builder.CreateCall(exitType, exitFunction, { ConstantInt::get(intType, 0) });
+  builder.CreateUnreachable();
+
+  builder.SetInsertPoint(fail);
+  builder.CreateCall(exitType, exitFunction, { ConstantInt::get(intType, 1) });
+  builder.CreateUnreachable();
+
+  builder.SetInsertPoint(done);
+  builder.CreateRetVoid();
+
+  /// The lowest priority: the server should start after the static initializers did their job
+  appendToGlobalCtors(module, server, 65535);
+}
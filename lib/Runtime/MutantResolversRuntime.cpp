@@ -0,0 +1,105 @@
+#include "mull/Runtime/MutantResolversRuntime.h"
+
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Transforms/Utils/ModuleUtils.h>
+
+using namespace llvm;
+
+static const char *MutantResolversName = "mull_mutant_resolvers";
+
+/// Resolvers must run before any other static initializer as those may call mutated functions
+static const int MutantResolverPriority = 0;
+
+StructType *mull::getMutantResolverType(LLVMContext &context) {
+  Type *resolverPtr = FunctionType::get(Type::getVoidTy(context), false)->getPointerTo();
+  Type *charPtr = Type::getInt8Ty(context)->getPointerTo();
+  return StructType::get(context, { resolverPtr, charPtr });
+}
+
+GlobalVariable *mull::getOrInsertMutantResolvers(Module &module) {
+  if (GlobalVariable *resolvers = module.getNamedGlobal(MutantResolversName)) {
+    return resolvers;
+  }
+  Type *charPtr = Type::getInt8Ty(module.getContext())->getPointerTo();
+  return new GlobalVariable(module,
+                            charPtr,
+                            false,
+                            GlobalValue::WeakAnyLinkage,
+                            Constant::getNullValue(charPtr),
+                            MutantResolversName);
+}
+
+void mull::registerMutantResolver(Module &module, Function *resolver) {
+  LLVMContext &context = module.getContext();
+  StructType *nodeType = getMutantResolverType(context);
+  Type *charPtr = Type::getInt8Ty(context)->getPointerTo();
+  Type *intType = Type::getInt32Ty(context);
+
+  GlobalVariable *resolvers = getOrInsertMutantResolvers(module);
+  auto *node = new GlobalVariable(
+      module,
+      nodeType,
+      false,
+      GlobalValue::InternalLinkage,
+      ConstantStruct::get(nodeType, { resolver, Constant::getNullValue(charPtr) }),
+      "mull_mutant_resolver");
+
+  Function *registration = Function::Create(FunctionType::get(Type::getVoidTy(context), false),
+                                            GlobalValue::InternalLinkage,
+                                            "mull_register_mutant_resolver",
+                                            &module);
+  IRBuilder<> builder(BasicBlock::Create(context, "entry", registration));
+  Value *next = builder.CreateLoad(charPtr, resolvers, "next");
+  Value *nextField = builder.CreateInBoundsGEP(
+      nodeType, node, { ConstantInt::get(intType, 0), ConstantInt::get(intType, 1) });
+  builder.CreateStore(next, nextField);
+  builder.CreateStore(builder.CreateBitCast(node, charPtr), resolvers);
+  builder.CreateCall(resolver->getFunctionType(), resolver, {});
+  builder.CreateRetVoid();
+
+  appendToGlobalCtors(module, registration, MutantResolverPriority);
+}
+
+Function *mull::insertResolveAllMutants(Module &module) {
+  LLVMContext &context = module.getContext();
+  StructType *nodeType = getMutantResolverType(context);
+  FunctionType *resolverType = FunctionType::get(Type::getVoidTy(context), false);
+  Type *charPtr = Type::getInt8Ty(context)->getPointerTo();
+  Type *intType = Type::getInt32Ty(context);
+
+  GlobalVariable *resolvers = getOrInsertMutantResolvers(module);
+  Function *resolveAll = Function::Create(
+      resolverType, GlobalValue::InternalLinkage, "mull_resolve_all_mutants", &module);
+
+  BasicBlock *entry = BasicBlock::Create(context, "entry", resolveAll);
+  BasicBlock *header = BasicBlock::Create(context, "header", resolveAll);
+  BasicBlock *body = BasicBlock::Create(context, "body", resolveAll);
+  BasicBlock *exit = BasicBlock::Create(context, "exit", resolveAll);
+
+  IRBuilder<> builder(entry);
+  Value *head = builder.CreateLoad(charPtr, resolvers, "head");
+  builder.CreateBr(header);
+
+  builder.SetInsertPoint(header);
+  PHINode *current = builder.CreatePHI(charPtr, 2, "current");
+  current->addIncoming(head, entry);
+  builder.CreateCondBr(builder.CreateIsNull(current), exit, body);
+
+  builder.SetInsertPoint(body);
+  Value *node = builder.CreateBitCast(current, nodeType->getPointerTo());
+  Value *resolverField = builder.CreateInBoundsGEP(
+      nodeType, node, { ConstantInt::get(intType, 0), ConstantInt::get(intType, 0) });
+  Value *resolver = builder.CreateLoad(resolverType->getPointerTo(), resolverField, "resolver");
+  builder.CreateCall(resolverType, resolver, {});
+  Value *nextField = builder.CreateInBoundsGEP(
+      nodeType, node, { ConstantInt::get(intType, 0), ConstantInt::get(intType, 1) });
+  Value *next = builder.CreateLoad(charPtr, nextField, "next");
+  current->addIncoming(next, body);
+  builder.CreateBr(header);
+
+  builder.SetInsertPoint(exit);
+  builder.CreateRetVoid();
+
+  return resolveAll;
+}
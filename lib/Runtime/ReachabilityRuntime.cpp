@@ -0,0 +1,175 @@
+#include "mull/Runtime/ReachabilityRuntime.h"
+
+#include "LLVMCompatibility.h"
+
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Transforms/Utils/ModuleUtils.h>
+
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace llvm;
+
+const char *mull::ReachabilityEnvironmentVariable = "MULL_REACHABILITY";
+
+/// The bitmap must be mapped before any other static initializer calls the mutated functions
+static const int ReachabilityPriority = 0;
+
+size_t mull::ReachabilitySlots::add(const std::string &mutant) {
+  mutants.push_back(mutant);
+  return mutants.size() - 1;
+}
+
+size_t mull::ReachabilitySlots::size() const {
+  return mutants.size();
+}
+
+std::unordered_set<std::string>
+mull::ReachabilitySlots::unreachedMutants(const std::string &bitmap) const {
+  std::unordered_set<std::string> reached;
+  std::unordered_set<std::string> unreached;
+  for (size_t slot = 0; slot < mutants.size(); slot++) {
+    if (slot < bitmap.size() && bitmap[slot] != 0) {
+      reached.insert(mutants[slot]);
+    }
+  }
+  for (auto &mutant : mutants) {
+    if (reached.count(mutant) == 0) {
+      unreached.insert(mutant);
+    }
+  }
+  return unreached;
+}
+
+/// The probes write through mull_reachability_map, which points either to a private buffer,
+/// or to the part of the shared bitmap that belongs to the module:
+///
+///   if (path = getenv(MULL_REACHABILITY)) and (fd = open(path)) >= 0:
+///     size = lseek(fd, 0, SEEK_END)
+///     if size > last slot and (bitmap = mmap(size, fd)) != MAP_FAILED:
+///       mull_reachability_map = bitmap + first slot
+///     close(fd)
+void mull::insertReachabilityProbes(
+    Module &module, const std::vector<std::pair<Instruction *, size_t>> &probes) {
+  if (probes.empty()) {
+    return;
+  }
+  LLVMContext &context = module.getContext();
+  Type *int8Type = Type::getInt8Ty(context);
+  Type *intType = Type::getInt32Ty(context);
+  Type *sizeType = module.getDataLayout().getIntPtrType(context);
+  Type *charPtr = int8Type->getPointerTo();
+
+  size_t firstSlot = probes.front().second;
+  size_t lastSlot = probes.front().second;
+  for (auto &probe : probes) {
+    firstSlot = std::min(firstSlot, probe.second);
+    lastSlot = std::max(lastSlot, probe.second);
+  }
+  auto *bufferType = ArrayType::get(int8Type, lastSlot - firstSlot + 1);
+  auto *buffer = new GlobalVariable(module,
+                                    bufferType,
+                                    false,
+                                    GlobalValue::InternalLinkage,
+                                    ConstantAggregateZero::get(bufferType),
+                                    "mull_reachability_buffer");
+  Constant *zero = ConstantInt::get(intType, 0);
+  auto *map = new GlobalVariable(module,
+                                 charPtr,
+                                 false,
+                                 GlobalValue::InternalLinkage,
+                                 ConstantExpr::getInBoundsGetElementPtr(
+                                     bufferType, buffer, ArrayRef<Constant *>({ zero, zero })),
+                                 "mull_reachability_map");
+
+  for (auto &probe : probes) {
+    Instruction *instruction = probe.first;
+    BasicBlock *block = instruction->getParent();
+    IRBuilder<> builder(instruction);
+    if (isa<PHINode>(instruction) || instruction->isEHPad()) {
+      builder.SetInsertPoint(block, block->getFirstInsertionPt());
+    }
+    Value *bitmap = builder.CreateLoad(charPtr, map);
+    Value *slot = builder.CreateInBoundsGEP(
+        int8Type, bitmap, ConstantInt::get(sizeType, probe.second - firstSlot));
+    builder.CreateStore(ConstantInt::get(int8Type, 1), slot);
+  }
+
+  FunctionType *getenvType = FunctionType::get(charPtr, { charPtr }, false);
+  FunctionType *openType = FunctionType::get(intType, { charPtr, intType }, true);
+  FunctionType *lseekType = FunctionType::get(sizeType, { intType, sizeType, intType }, false);
+  FunctionType *mmapType = FunctionType::get(
+      charPtr, { charPtr, sizeType, intType, intType, intType, sizeType }, false);
+  FunctionType *closeType = FunctionType::get(intType, { intType }, false);
+  Value *getenvFunction = llvm_compat::getOrInsertFunction(&module, "getenv", getenvType);
+  Value *openFunction = llvm_compat::getOrInsertFunction(&module, "open", openType);
+  Value *lseekFunction = llvm_compat::getOrInsertFunction(&module, "lseek", lseekType);
+  Value *mmapFunction = llvm_compat::getOrInsertFunction(&module, "mmap", mmapType);
+  Value *closeFunction = llvm_compat::getOrInsertFunction(&module, "close", closeType);
+
+  Function *mapBitmap = Function::Create(FunctionType::get(Type::getVoidTy(context), false),
+                                         GlobalValue::InternalLinkage,
+                                         "mull_map_reachability",
+                                         &module);
+  BasicBlock *entry = BasicBlock::Create(context, "entry", mapBitmap);
+  BasicBlock *openFile = BasicBlock::Create(context, "open", mapBitmap);
+  BasicBlock *checkSize = BasicBlock::Create(context, "check_size", mapBitmap);
+  BasicBlock *mapFile = BasicBlock::Create(context, "map", mapBitmap);
+  BasicBlock *publish = BasicBlock::Create(context, "publish", mapBitmap);
+  BasicBlock *closeFile = BasicBlock::Create(context, "close", mapBitmap);
+  BasicBlock *done = BasicBlock::Create(context, "done", mapBitmap);
+
+  IRBuilder<> builder(entry);
+  Value *path = builder.CreateCall(
+      getenvType,
+      getenvFunction,
+      { builder.CreateGlobalStringPtr(ReachabilityEnvironmentVariable, "mull_reachability_env") });
+  builder.CreateCondBr(builder.CreateIsNull(path), done, openFile);
+
+  builder.SetInsertPoint(openFile);
+  Value *descriptor =
+      builder.CreateCall(openType, openFunction, { path, ConstantInt::get(intType, O_RDWR) });
+  builder.CreateCondBr(
+      builder.CreateICmpSLT(descriptor, ConstantInt::get(intType, 0)), done, checkSize);
+
+  builder.SetInsertPoint(checkSize);
+  Value *size = builder.CreateCall(lseekType,
+                                   lseekFunction,
+                                   { descriptor,
+                                     ConstantInt::get(sizeType, 0),
+                                     ConstantInt::get(intType, SEEK_END) });
+  builder.CreateCondBr(builder.CreateICmpSLE(size, ConstantInt::get(sizeType, lastSlot)),
+                       closeFile,
+                       mapFile);
+
+  builder.SetInsertPoint(mapFile);
+  Value *bitmap = builder.CreateCall(mmapType,
+                                     mmapFunction,
+                                     { Constant::getNullValue(charPtr),
+                                       size,
+                                       ConstantInt::get(intType, PROT_READ | PROT_WRITE),
+                                       ConstantInt::get(intType, MAP_SHARED),
+                                       descriptor,
+                                       ConstantInt::get(sizeType, 0) });
+  Value *mapFailed = builder.CreateICmpEQ(builder.CreatePtrToInt(bitmap, sizeType),
+                                          ConstantInt::getAllOnesValue(sizeType));
+  builder.CreateCondBr(mapFailed, closeFile, publish);
+
+  builder.SetInsertPoint(publish);
+  builder.CreateStore(
+      builder.CreateInBoundsGEP(int8Type, bitmap, ConstantInt::get(sizeType, firstSlot)), map);
+  builder.CreateBr(closeFile);
+
+  /// The mapping stays valid after the descriptor is closed
+  builder.SetInsertPoint(closeFile);
+  builder.CreateCall(closeType, closeFunction, { descriptor });
+  builder.CreateBr(done);
+
+  builder.SetInsertPoint(done);
+  builder.CreateRetVoid();
+
+  appendToGlobalCtors(module, mapBitmap, ReachabilityPriority);
+}
@@ -0,0 +1,226 @@
+#include "mull/Runtime/TestCoverageRuntime.h"
+
+#include "LLVMCompatibility.h"
+
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Transforms/Utils/ModuleUtils.h>
+
+#include <fcntl.h>
+#include <sstream>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace llvm;
+
+const char *mull::TestCoverageEnvironmentVariable = "MULL_TEST_COVERAGE";
+const char *mull::TestCoverageMarker = "mull-coverage ";
+
+/// The flags must be mapped before any other static initializer calls the trampolines
+static const int TestCoveragePriority = 0;
+
+/// The probes write through mull_test_coverage_map, which points either to a private buffer,
+/// or to the flags of the record the module appended to the file:
+///
+///   if (path = getenv(MULL_TEST_COVERAGE)) and (fd = open(path, O_RDWR | O_APPEND)) >= 0:
+///     if write(fd, record) == size of record:
+///       end = lseek(fd, 0, SEEK_CUR)
+///       start = (end - flags count) rounded down to the page size
+///       if (page = mmap(end - start, fd, start)) != MAP_FAILED:
+///         mull_test_coverage_map = page + (end - flags count - start)
+///     close(fd)
+void mull::insertTestCoverage(Module &module,
+                              const std::map<Function *, std::vector<std::string>> &mutants) {
+  if (mutants.empty()) {
+    return;
+  }
+  LLVMContext &context = module.getContext();
+  Type *int8Type = Type::getInt8Ty(context);
+  Type *intType = Type::getInt32Ty(context);
+  Type *sizeType = module.getDataLayout().getIntPtrType(context);
+  Type *charPtr = int8Type->getPointerTo();
+  Constant *zero = ConstantInt::get(intType, 0);
+
+  size_t flagsCount = mutants.size();
+  size_t linesCount = 0;
+  std::stringstream record;
+  for (auto &pair : mutants) {
+    linesCount += pair.second.size();
+  }
+  record << TestCoverageMarker << flagsCount << ' ' << linesCount << '\n';
+  size_t flag = 0;
+  for (auto &pair : mutants) {
+    for (auto &identifier : pair.second) {
+      record << flag << ' ' << identifier << '\n';
+    }
+    flag++;
+  }
+  record << std::string(flagsCount, '\0');
+
+  Constant *recordData = ConstantDataArray::getString(context, record.str(), false);
+  auto *recordGlobal = new GlobalVariable(module,
+                                          recordData->getType(),
+                                          true,
+                                          GlobalValue::PrivateLinkage,
+                                          recordData,
+                                          "mull_test_coverage_record");
+  auto *bufferType = ArrayType::get(int8Type, flagsCount);
+  auto *buffer = new GlobalVariable(module,
+                                    bufferType,
+                                    false,
+                                    GlobalValue::InternalLinkage,
+                                    ConstantAggregateZero::get(bufferType),
+                                    "mull_test_coverage_buffer");
+  auto *map = new GlobalVariable(module,
+                                 charPtr,
+                                 false,
+                                 GlobalValue::InternalLinkage,
+                                 ConstantExpr::getInBoundsGetElementPtr(
+                                     bufferType, buffer, ArrayRef<Constant *>({ zero, zero })),
+                                 "mull_test_coverage_map");
+
+  flag = 0;
+  for (auto &pair : mutants) {
+    BasicBlock &entry = pair.first->getEntryBlock();
+    IRBuilder<> builder(&entry, entry.getFirstInsertionPt());
+    Value *flags = builder.CreateLoad(charPtr, map);
+    Value *slot = builder.CreateInBoundsGEP(int8Type, flags, ConstantInt::get(sizeType, flag++));
+    builder.CreateStore(ConstantInt::get(int8Type, 1), slot);
+  }
+
+  FunctionType *getenvType = FunctionType::get(charPtr, { charPtr }, false);
+  FunctionType *openType = FunctionType::get(intType, { charPtr, intType }, true);
+  FunctionType *writeType = FunctionType::get(sizeType, { intType, charPtr, sizeType }, false);
+  FunctionType *lseekType = FunctionType::get(sizeType, { intType, sizeType, intType }, false);
+  FunctionType *pageSizeType = FunctionType::get(intType, false);
+  FunctionType *mmapType = FunctionType::get(
+      charPtr, { charPtr, sizeType, intType, intType, intType, sizeType }, false);
+  FunctionType *closeType = FunctionType::get(intType, { intType }, false);
+  Value *getenvFunction = llvm_compat::getOrInsertFunction(&module, "getenv", getenvType);
+  Value *openFunction = llvm_compat::getOrInsertFunction(&module, "open", openType);
+  Value *writeFunction = llvm_compat::getOrInsertFunction(&module, "write", writeType);
+  Value *lseekFunction = llvm_compat::getOrInsertFunction(&module, "lseek", lseekType);
+  Value *pageSizeFunction =
+      llvm_compat::getOrInsertFunction(&module, "getpagesize", pageSizeType);
+  Value *mmapFunction = llvm_compat::getOrInsertFunction(&module, "mmap", mmapType);
+  Value *closeFunction = llvm_compat::getOrInsertFunction(&module, "close", closeType);
+
+  Function *mapFlags = Function::Create(FunctionType::get(Type::getVoidTy(context), false),
+                                        GlobalValue::InternalLinkage,
+                                        "mull_map_test_coverage",
+                                        &module);
+  BasicBlock *entry = BasicBlock::Create(context, "entry", mapFlags);
+  BasicBlock *openFile = BasicBlock::Create(context, "open", mapFlags);
+  BasicBlock *writeRecord = BasicBlock::Create(context, "write", mapFlags);
+  BasicBlock *mapFile = BasicBlock::Create(context, "map", mapFlags);
+  BasicBlock *publish = BasicBlock::Create(context, "publish", mapFlags);
+  BasicBlock *closeFile = BasicBlock::Create(context, "close", mapFlags);
+  BasicBlock *done = BasicBlock::Create(context, "done", mapFlags);
+
+  IRBuilder<> builder(entry);
+  Value *path = builder.CreateCall(
+      getenvType,
+      getenvFunction,
+      { builder.CreateGlobalStringPtr(TestCoverageEnvironmentVariable, "mull_test_coverage_env") });
+  builder.CreateCondBr(builder.CreateIsNull(path), done, openFile);
+
+  builder.SetInsertPoint(openFile);
+  Value *descriptor = builder.CreateCall(
+      openType, openFunction, { path, ConstantInt::get(intType, O_RDWR | O_APPEND) });
+  builder.CreateCondBr(
+      builder.CreateICmpSLT(descriptor, ConstantInt::get(intType, 0)), done, writeRecord);
+
+  builder.SetInsertPoint(writeRecord);
+  Value *recordSize = ConstantInt::get(sizeType, record.str().size());
+  Value *written = builder.CreateCall(
+      writeType,
+      writeFunction,
+      { descriptor,
+        ConstantExpr::getInBoundsGetElementPtr(
+            recordData->getType(), recordGlobal, ArrayRef<Constant *>({ zero, zero })),
+        recordSize });
+  builder.CreateCondBr(builder.CreateICmpNE(written, recordSize), closeFile, mapFile);
+
+  /// With O_APPEND the offset is at the end of the record once it is written
+  builder.SetInsertPoint(mapFile);
+  Value *end = builder.CreateCall(
+      lseekType,
+      lseekFunction,
+      { descriptor, ConstantInt::get(sizeType, 0), ConstantInt::get(intType, SEEK_CUR) });
+  Value *flagsOffset = builder.CreateSub(end, ConstantInt::get(sizeType, flagsCount));
+  Value *pageSize =
+      builder.CreateZExtOrTrunc(builder.CreateCall(pageSizeType, pageSizeFunction), sizeType);
+  Value *start = builder.CreateAnd(flagsOffset, builder.CreateNeg(pageSize));
+  Value *page = builder.CreateCall(mmapType,
+                                   mmapFunction,
+                                   { Constant::getNullValue(charPtr),
+                                     builder.CreateSub(end, start),
+                                     ConstantInt::get(intType, PROT_READ | PROT_WRITE),
+                                     ConstantInt::get(intType, MAP_SHARED),
+                                     descriptor,
+                                     start });
+  Value *mapFailed = builder.CreateICmpEQ(builder.CreatePtrToInt(page, sizeType),
+                                          ConstantInt::getAllOnesValue(sizeType));
+  builder.CreateCondBr(mapFailed, closeFile, publish);
+
+  builder.SetInsertPoint(publish);
+  builder.CreateStore(
+      builder.CreateInBoundsGEP(int8Type, page, builder.CreateSub(flagsOffset, start)), map);
+  builder.CreateBr(closeFile);
+
+  /// The mapping stays valid after the descriptor is closed
+  builder.SetInsertPoint(closeFile);
+  builder.CreateCall(closeType, closeFunction, { descriptor });
+  builder.CreateBr(done);
+
+  builder.SetInsertPoint(done);
+  builder.CreateRetVoid();
+
+  appendToGlobalCtors(module, mapFlags, TestCoveragePriority);
+}
+
+bool mull::parseTestCoverage(const std::string &contents, std::vector<std::string> &identifiers) {
+  std::string marker(TestCoverageMarker);
+  size_t position = 0;
+  while (position < contents.size()) {
+    size_t headerEnd = contents.find('\n', position);
+    if (headerEnd == std::string::npos || contents.compare(position, marker.size(), marker) != 0) {
+      return false;
+    }
+    size_t flagsCount = 0;
+    size_t linesCount = 0;
+    std::istringstream header(
+        contents.substr(position + marker.size(), headerEnd - position - marker.size()));
+    if (!(header >> flagsCount >> linesCount)) {
+      return false;
+    }
+    position = headerEnd + 1;
+
+    std::vector<std::pair<size_t, std::string>> mutants;
+    for (size_t line = 0; line < linesCount; line++) {
+      size_t lineEnd = contents.find('\n', position);
+      size_t separator = contents.find(' ', position);
+      if (lineEnd == std::string::npos || separator > lineEnd) {
+        return false;
+      }
+      size_t flag = 0;
+      std::istringstream index(contents.substr(position, separator - position));
+      if (!(index >> flag) || flag >= flagsCount) {
+        return false;
+      }
+      mutants.emplace_back(flag, contents.substr(separator + 1, lineEnd - separator - 1));
+      position = lineEnd + 1;
+    }
+
+    if (contents.size() - position < flagsCount) {
+      return false;
+    }
+    for (auto &mutant : mutants) {
+      if (contents[position + mutant.first] != 0) {
+        identifiers.push_back(mutant.second);
+      }
+    }
+    position += flagsCount;
+  }
+  return true;
+}
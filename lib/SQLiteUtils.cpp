@@ -0,0 +1,48 @@
+#include "mull/SQLiteUtils.h"
+
+#include "mull/Diagnostics/Diagnostics.h"
+
+#include <sqlite3.h>
+
+using namespace mull;
+
+bool sqlite::execute(sqlite3 *database, const char *sql, std::string &error) {
+  char *errorMessage = nullptr;
+  if (sqlite3_exec(database, sql, nullptr, nullptr, &errorMessage) != SQLITE_OK) {
+    error = errorMessage ? errorMessage : "unknown error";
+    sqlite3_free(errorMessage);
+    return false;
+  }
+  return true;
+}
+
+bool sqlite::execute(Diagnostics &diagnostics, sqlite3 *database, const char *sql,
+                     const std::string &description) {
+  std::string error;
+  if (!execute(database, sql, error)) {
+    diagnostics.warning("Cannot update " + description + ": " + error);
+    return false;
+  }
+  return true;
+}
+
+sqlite3 *sqlite::openDatabase(Diagnostics &diagnostics, const std::string &path,
+                              const char *createTables, const std::string &description) {
+  sqlite3 *database = nullptr;
+  if (sqlite3_open(path.c_str(), &database) != SQLITE_OK) {
+    diagnostics.warning("Cannot open " + description + " " + path + ": " +
+                        sqlite3_errmsg(database));
+    sqlite3_close(database);
+    return nullptr;
+  }
+  if (!execute(diagnostics, database, createTables, description)) {
+    sqlite3_close(database);
+    return nullptr;
+  }
+  return database;
+}
+
+std::string sqlite::columnText(sqlite3_stmt *statement, int column) {
+  auto text = reinterpret_cast<const char *>(sqlite3_column_text(statement, column));
+  return text ? text : "";
+}
@@ -0,0 +1,369 @@
+#include "mull/Sharding.h"
+
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Hashing.h"
+#include "mull/Mutant.h"
+#include "mull/MutationResult.h"
+#include "mull/Result.h"
+#include "mull/SQLiteUtils.h"
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <sqlite3.h>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace mull;
+
+MutantSet mull::describeMutants(const std::vector<std::unique_ptr<Mutant>> &mutants) {
+  std::vector<std::string> identifiers;
+  for (auto &mutant : mutants) {
+    identifiers.push_back(mutant->getIdentifier());
+  }
+  std::sort(identifiers.begin(), identifiers.end());
+  llvm::MD5 hash;
+  for (auto &identifier : identifiers) {
+    hash.update(identifier);
+    hash.update("\n");
+  }
+
+  MutantSet mutantSet;
+  mutantSet.count = mutants.size();
+  mutantSet.hash = hexDigest(hash);
+  return mutantSet;
+}
+
+std::vector<std::unique_ptr<Mutant>> mull::selectShard(std::vector<std::unique_ptr<Mutant>> mutants,
+                                                       const MutantCost &cost, unsigned shardIndex,
+                                                       unsigned shardCount) {
+  if (shardCount <= 1) {
+    return mutants;
+  }
+
+  std::vector<long long> costs;
+  for (auto &mutant : mutants) {
+    costs.push_back(std::max(0LL, cost(*mutant)));
+  }
+
+  /// Longest processing time first: the most expensive mutant goes to the least loaded shard.
+  /// Ties are resolved by the position in the sorted list and by the shard index,
+  /// so the result depends only on the input
+  std::vector<size_t> order(mutants.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(
+      order.begin(), order.end(), [&](size_t lhs, size_t rhs) { return costs[lhs] > costs[rhs]; });
+
+  /// The mutant count breaks ties between equally loaded shards, e.g. for zero cost mutants
+  std::vector<std::pair<long long, size_t>> loads(shardCount, { 0, 0 });
+  std::vector<unsigned> assignment(mutants.size());
+  for (size_t index : order) {
+    auto lightest = std::min_element(loads.begin(), loads.end());
+    assignment[index] = unsigned(lightest - loads.begin());
+    lightest->first += costs[index];
+    lightest->second++;
+  }
+
+  std::vector<std::unique_ptr<Mutant>> shard;
+  for (size_t index = 0; index < mutants.size(); index++) {
+    if (assignment[index] == shardIndex) {
+      shard.push_back(std::move(mutants[index]));
+    }
+  }
+  return shard;
+}
+
+std::string mull::partialResultPath(const std::string &directory, const std::string &name,
+                                    unsigned shardIndex, unsigned shardCount) {
+  std::stringstream filename;
+  filename << (name.empty() ? "mull" : name) << "-shard-" << shardIndex << "-of-" << shardCount
+           << ".sqlite";
+  llvm::SmallString<256> path(directory.empty() ? "." : directory);
+  llvm::sys::path::append(path, filename.str());
+  return path.str().str();
+}
+
+#pragma mark - Partial Result Schema
+
+static const char *CreateTables = R"CreateTables(
+CREATE TABLE shard (
+  shard_index INT,
+  shard_count INT,
+  mutant_count INT,
+  mutants_hash TEXT
+);
+
+CREATE TABLE mutant (
+  unique_id TEXT,
+  mutator TEXT,
+  mutator_kind INT,
+  covered INT,
+  unit_directory TEXT,
+  unit_filename TEXT,
+  directory TEXT,
+  filename TEXT,
+  line_number INT,
+  column_number INT,
+  end_unit_directory TEXT,
+  end_unit_filename TEXT,
+  end_directory TEXT,
+  end_filename TEXT,
+  end_line_number INT,
+  end_column_number INT
+);
+
+CREATE TABLE execution_result (
+  mutant_id TEXT,
+  status INT,
+  status_source INT,
+  exit_status INT,
+  duration INT,
+  stdout TEXT,
+  stderr TEXT
+);
+)CreateTables";
+
+static void bindLocation(sqlite3_stmt *statement, int &index, const SourceLocation &location) {
+  sqlite3_bind_text(statement, index++, location.unitDirectory.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(statement, index++, location.unitFilePath.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(statement, index++, location.directory.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_text(statement, index++, location.filePath.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_bind_int(statement, index++, location.line);
+  sqlite3_bind_int(statement, index++, location.column);
+}
+
+static SourceLocation columnLocation(sqlite3_stmt *statement, int &index) {
+  std::string unitDirectory = sqlite::columnText(statement, index++);
+  std::string unitFilePath = sqlite::columnText(statement, index++);
+  std::string directory = sqlite::columnText(statement, index++);
+  std::string filePath = sqlite::columnText(statement, index++);
+  int line = sqlite3_column_int(statement, index++);
+  int column = sqlite3_column_int(statement, index++);
+  return SourceLocation(unitDirectory, unitFilePath, directory, filePath, line, column);
+}
+
+void mull::writePartialResult(Diagnostics &diagnostics, const std::string &path,
+                              const Result &result, unsigned shardIndex, unsigned shardCount,
+                              const MutantSet &allMutants) {
+  /// A leftover from a previous run would mix two sets of results
+  llvm::sys::fs::remove(path);
+  llvm::sys::fs::create_directories(llvm::sys::path::parent_path(path), true);
+
+  sqlite3 *database = nullptr;
+  if (sqlite3_open(path.c_str(), &database) != SQLITE_OK) {
+    std::string reason = sqlite3_errmsg(database);
+    sqlite3_close(database);
+    diagnostics.error("Cannot write partial result " + path + ": " + reason);
+    return;
+  }
+  std::string error;
+  if (!sqlite::execute(database, CreateTables, error) ||
+      !sqlite::execute(database, "BEGIN TRANSACTION", error)) {
+    sqlite3_close(database);
+    diagnostics.error("Cannot write partial result " + path + ": " + error);
+    return;
+  }
+
+  sqlite3_stmt *statement = nullptr;
+  sqlite3_prepare_v2(
+      database, "INSERT INTO shard VALUES (?1, ?2, ?3, ?4)", -1, &statement, nullptr);
+  sqlite3_bind_int(statement, 1, int(shardIndex));
+  sqlite3_bind_int(statement, 2, int(shardCount));
+  sqlite3_bind_int64(statement, 3, (long long)allMutants.count);
+  sqlite3_bind_text(statement, 4, allMutants.hash.c_str(), -1, SQLITE_TRANSIENT);
+  sqlite3_step(statement);
+  sqlite3_finalize(statement);
+
+  sqlite3_prepare_v2(database,
+                     "INSERT INTO mutant VALUES "
+                     "(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14, ?15, ?16)",
+                     -1,
+                     &statement,
+                     nullptr);
+  for (auto &mutant : result.getMutants()) {
+    int index = 1;
+    sqlite3_bind_text(statement, index++, mutant->getIdentifier().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(
+        statement, index++, mutant->getMutatorIdentifier().c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int(statement, index++, static_cast<int>(mutant->getMutatorKind()));
+    sqlite3_bind_int(statement, index++, mutant->isCovered());
+    bindLocation(statement, index, mutant->getSourceLocation());
+    bindLocation(statement, index, mutant->getEndLocation());
+    sqlite3_step(statement);
+    sqlite3_clear_bindings(statement);
+    sqlite3_reset(statement);
+  }
+  sqlite3_finalize(statement);
+
+  sqlite3_prepare_v2(database,
+                     "INSERT INTO execution_result VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7)",
+                     -1,
+                     &statement,
+                     nullptr);
+  for (auto &mutationResult : result.getMutationResults()) {
+    ExecutionResult &executionResult = mutationResult->getExecutionResult();
+    int index = 1;
+    sqlite3_bind_text(statement,
+                      index++,
+                      mutationResult->getMutant()->getIdentifier().c_str(),
+                      -1,
+                      SQLITE_TRANSIENT);
+    sqlite3_bind_int(statement, index++, executionResult.status);
+    sqlite3_bind_int(statement, index++, static_cast<int>(executionResult.source));
+    sqlite3_bind_int(statement, index++, executionResult.exitStatus);
+    sqlite3_bind_int64(statement, index++, executionResult.runningTime);
+    sqlite3_bind_text(
+        statement, index++, executionResult.stdoutOutput.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_text(
+        statement, index++, executionResult.stderrOutput.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_step(statement);
+    sqlite3_clear_bindings(statement);
+    sqlite3_reset(statement);
+  }
+  sqlite3_finalize(statement);
+
+  bool committed = sqlite::execute(database, "END TRANSACTION", error);
+  sqlite3_close(database);
+  if (!committed) {
+    diagnostics.error("Cannot write partial result " + path + ": " + error);
+  }
+
+  diagnostics.info("Partial result of shard " + std::to_string(shardIndex) + "/" +
+                   std::to_string(shardCount) + " can be found at '" + path + "'");
+}
+
+std::unique_ptr<Result> mull::mergePartialResults(Diagnostics &diagnostics,
+                                                  const std::vector<std::string> &paths) {
+  std::vector<std::unique_ptr<Mutant>> mutants;
+  std::vector<std::unique_ptr<MutationResult>> mutationResults;
+  std::unordered_map<std::string, Mutant *> mutantsById;
+  std::set<unsigned> seenShards;
+  unsigned expectedShardCount = 0;
+  MutantSet expectedMutants;
+  size_t duplicates = 0;
+
+  for (auto &path : paths) {
+    sqlite3 *database = nullptr;
+    if (sqlite3_open_v2(path.c_str(), &database, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK) {
+      std::string reason = sqlite3_errmsg(database);
+      sqlite3_close(database);
+      diagnostics.error("Cannot read partial result " + path + ": " + reason);
+    }
+
+    sqlite3_stmt *statement = nullptr;
+    bool hasShard = false;
+    unsigned shardIndex = 0;
+    unsigned shardCount = 0;
+    MutantSet allMutants;
+    if (sqlite3_prepare_v2(database,
+                           "SELECT shard_index, shard_count, mutant_count, mutants_hash FROM shard",
+                           -1,
+                           &statement,
+                           nullptr) == SQLITE_OK &&
+        sqlite3_step(statement) == SQLITE_ROW) {
+      hasShard = true;
+      shardIndex = unsigned(sqlite3_column_int(statement, 0));
+      shardCount = unsigned(sqlite3_column_int(statement, 1));
+      allMutants.count = size_t(sqlite3_column_int64(statement, 2));
+      allMutants.hash = sqlite::columnText(statement, 3);
+    }
+    sqlite3_finalize(statement);
+    if (!hasShard) {
+      sqlite3_close(database);
+      diagnostics.error("Not a partial result: " + path);
+    }
+    if (expectedShardCount == 0) {
+      expectedShardCount = shardCount;
+      expectedMutants = allMutants;
+    } else if (shardCount != expectedShardCount) {
+      sqlite3_close(database);
+      std::stringstream message;
+      message << path << " belongs to a run with " << shardCount << " shards, expected "
+              << expectedShardCount;
+      diagnostics.error(message.str());
+    } else if (allMutants.hash != expectedMutants.hash) {
+      /// The shards were selected from different mutants, they may overlap or leave gaps
+      sqlite3_close(database);
+      diagnostics.error(path + " belongs to a run with a different set of mutants");
+    }
+    if (!seenShards.insert(shardIndex).second) {
+      diagnostics.warning("Shard " + std::to_string(shardIndex) + " is given more than once: " +
+                          path);
+    }
+
+    /// A mutant found in several files keeps the result from the first one
+    std::unordered_set<std::string> ownMutants;
+    sqlite3_prepare_v2(database, "SELECT * FROM mutant", -1, &statement, nullptr);
+    while (sqlite3_step(statement) == SQLITE_ROW) {
+      int index = 0;
+      std::string identifier = sqlite::columnText(statement, index++);
+      std::string mutator = sqlite::columnText(statement, index++);
+      auto mutatorKind = static_cast<MutatorKind>(sqlite3_column_int(statement, index++));
+      bool covered = sqlite3_column_int(statement, index++);
+      SourceLocation location = columnLocation(statement, index);
+      SourceLocation endLocation = columnLocation(statement, index);
+      if (mutantsById.count(identifier)) {
+        duplicates++;
+        continue;
+      }
+      auto mutant = std::make_unique<Mutant>(identifier, mutator, location, endLocation, covered);
+      mutant->setMutatorKind(mutatorKind);
+      mutantsById[identifier] = mutant.get();
+      ownMutants.insert(identifier);
+      mutants.push_back(std::move(mutant));
+    }
+    sqlite3_finalize(statement);
+
+    sqlite3_prepare_v2(database, "SELECT * FROM execution_result", -1, &statement, nullptr);
+    while (sqlite3_step(statement) == SQLITE_ROW) {
+      std::string identifier = sqlite::columnText(statement, 0);
+      if (ownMutants.count(identifier) == 0) {
+        continue;
+      }
+      ExecutionResult result;
+      result.status = ExecutionStatus(sqlite3_column_int(statement, 1));
+      result.source = StatusSource(sqlite3_column_int(statement, 2));
+      result.exitStatus = sqlite3_column_int(statement, 3);
+      result.runningTime = sqlite3_column_int64(statement, 4);
+      result.stdoutOutput = sqlite::columnText(statement, 5);
+      result.stderrOutput = sqlite::columnText(statement, 6);
+      mutationResults.push_back(
+          std::make_unique<MutationResult>(result, mutantsById[identifier]));
+    }
+    sqlite3_finalize(statement);
+    sqlite3_close(database);
+  }
+
+  if (duplicates != 0) {
+    diagnostics.warning(std::to_string(duplicates) +
+                        " mutants are present in several shards, the first result is used");
+  }
+  for (unsigned shard = 0; shard < expectedShardCount; shard++) {
+    if (seenShards.count(shard) == 0) {
+      std::stringstream message;
+      message << "Partial result of shard " << shard << "/" << expectedShardCount
+              << " is missing, the merged result is incomplete";
+      diagnostics.error(message.str());
+    }
+  }
+  if (mutants.size() != expectedMutants.count) {
+    std::stringstream message;
+    message << "The partial results contain " << mutants.size() << " of "
+            << expectedMutants.count << " mutants, the merged result is incomplete";
+    diagnostics.error(message.str());
+  }
+
+  std::sort(mutants.begin(), mutants.end(), MutantComparator());
+  std::sort(mutationResults.begin(),
+            mutationResults.end(),
+            [](const std::unique_ptr<MutationResult> &lhs,
+               const std::unique_ptr<MutationResult> &rhs) {
+              return MutantComparator()(*lhs->getMutant(), *rhs->getMutant());
+            });
+  return std::make_unique<Result>(std::move(mutants), std::move(mutationResults));
+}
@@ -0,0 +1,141 @@
+#include "mull/TestHistory.h"
+
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/SQLiteUtils.h"
+
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+#include <sqlite3.h>
+
+using namespace mull;
+
+static const char *CreateTables = R"CreateTables(
+CREATE TABLE IF NOT EXISTS test_kill (
+  mutant TEXT,
+  test TEXT,
+  runs INT,
+  kills INT,
+  PRIMARY KEY (mutant, test)
+);
+)CreateTables";
+
+static const char *Description = "test history";
+
+TestHistory::TestHistory(Diagnostics &diagnostics, std::string databasePath)
+    : diagnostics(diagnostics), databasePath(std::move(databasePath)) {}
+
+const std::string &TestHistory::getDatabasePath() const {
+  return databasePath;
+}
+
+void TestHistory::load() {
+  if (!llvm::sys::fs::exists(databasePath)) {
+    return;
+  }
+  sqlite3 *database = sqlite::openDatabase(diagnostics, databasePath, CreateTables, Description);
+  if (!database) {
+    return;
+  }
+  sqlite3_stmt *statement = nullptr;
+  sqlite3_prepare_v2(
+      database, "SELECT mutant, test, runs, kills FROM test_kill", -1, &statement, nullptr);
+  while (sqlite3_step(statement) == SQLITE_ROW) {
+    Record record;
+    record.runs = sqlite3_column_int64(statement, 2);
+    record.kills = sqlite3_column_int64(statement, 3);
+    std::string test = sqlite::columnText(statement, 1);
+    history[std::make_pair(sqlite::columnText(statement, 0), test)] = record;
+    testTotals[test].runs += record.runs;
+    testTotals[test].kills += record.kills;
+  }
+  sqlite3_finalize(statement);
+  sqlite3_close(database);
+}
+
+void TestHistory::save() {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (newRuns.empty()) {
+    return;
+  }
+  llvm::sys::fs::create_directories(llvm::sys::path::parent_path(databasePath), true);
+  sqlite3 *database = sqlite::openDatabase(diagnostics, databasePath, CreateTables, Description);
+  if (!database) {
+    return;
+  }
+  sqlite::execute(diagnostics, database, "BEGIN TRANSACTION", Description);
+  /// Plain INSERT OR IGNORE + UPDATE instead of an upsert, which older SQLite versions lack
+  sqlite3_stmt *insert = nullptr;
+  sqlite3_prepare_v2(database,
+                     "INSERT OR IGNORE INTO test_kill VALUES (?1, ?2, 0, 0)",
+                     -1,
+                     &insert,
+                     nullptr);
+  sqlite3_stmt *update = nullptr;
+  sqlite3_prepare_v2(database,
+                     "UPDATE test_kill SET runs = runs + ?3, kills = kills + ?4 "
+                     "WHERE mutant = ?1 AND test = ?2",
+                     -1,
+                     &update,
+                     nullptr);
+  for (auto &pair : newRuns) {
+    for (sqlite3_stmt *statement : { insert, update }) {
+      sqlite3_bind_text(statement, 1, pair.first.first.c_str(), -1, SQLITE_TRANSIENT);
+      sqlite3_bind_text(statement, 2, pair.first.second.c_str(), -1, SQLITE_TRANSIENT);
+      if (statement == update) {
+        sqlite3_bind_int64(statement, 3, pair.second.runs);
+        sqlite3_bind_int64(statement, 4, pair.second.kills);
+      }
+      sqlite3_step(statement);
+      sqlite3_clear_bindings(statement);
+      sqlite3_reset(statement);
+    }
+  }
+  sqlite3_finalize(insert);
+  sqlite3_finalize(update);
+  sqlite::execute(diagnostics, database, "END TRANSACTION", Description);
+  sqlite3_close(database);
+  newRuns.clear();
+}
+
+/// Laplace smoothing: a few runs without kills do not rule a test out.
+/// A test that never ran against the mutant falls back to its kill rate across all mutants.
+double TestHistory::killProbability(const std::string &mutant, const std::string &test) const {
+  auto record = history.find(std::make_pair(mutant, test));
+  if (record != history.end()) {
+    return double(record->second.kills + 1) / double(record->second.runs + 2);
+  }
+  auto total = testTotals.find(test);
+  if (total != testTotals.end()) {
+    return double(total->second.kills + 1) / double(total->second.runs + 2);
+  }
+  return 0.5;
+}
+
+std::vector<std::string>
+TestHistory::prioritize(const std::string &mutant, std::vector<std::string> tests,
+                        const std::unordered_map<std::string, long long> &durations) const {
+  std::unordered_map<std::string, double> scores;
+  for (auto &test : tests) {
+    long long duration = 0;
+    auto it = durations.find(test);
+    if (it != durations.end()) {
+      duration = it->second;
+    }
+    scores[test] = killProbability(mutant, test) / double(duration + 1);
+  }
+  std::stable_sort(tests.begin(), tests.end(), [&](const std::string &lhs, const std::string &rhs) {
+    return scores[lhs] > scores[rhs];
+  });
+  return tests;
+}
+
+void TestHistory::recordRun(const std::string &mutant, const std::string &test, bool killed) {
+  std::lock_guard<std::mutex> lock(mutex);
+  Record &record = newRuns[std::make_pair(mutant, test)];
+  record.runs++;
+  if (killed) {
+    record.kills++;
+  }
+}
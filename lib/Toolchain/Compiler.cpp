@@ -4,14 +4,26 @@
 #include "mull/Bitcode.h"
 #include "mull/Config/Configuration.h"
 #include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Metrics/MetricsMeasure.h"
+#include "mull/MutationPoint.h"
 
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/Triple.h>
+#include <llvm/IR/DebugInfo.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Verifier.h>
+#include <llvm/MC/SubtargetFeature.h>
 #include <llvm/Support/DynamicLibrary.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Support/TargetRegistry.h>
+#include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
+#include <llvm/Transforms/IPO/PassManagerBuilder.h>
+
+#include <sstream>
+#include <unordered_set>
 
 using namespace llvm;
 using namespace llvm::object;
@@ -19,7 +31,69 @@ using namespace mull;
 using namespace std::string_literals;
 
 Compiler::Compiler(Diagnostics &diagnostics, const Configuration &configuration)
-    : diagnostics(diagnostics), configuration(configuration) {}
+    : diagnostics(diagnostics), configuration(configuration),
+      objectCache(diagnostics, configuration.cacheDirectory),
+      codegenProfile(configuration.codegenProfile) {}
+
+Compiler::~Compiler() = default;
+
+void Compiler::setCodegenProfile(CodegenProfile profile) {
+  codegenProfile = profile;
+}
+
+CodegenPipeline mull::codegenPipeline(CodegenProfile profile) {
+  switch (profile) {
+  case CodegenProfile::FastCompile:
+    return { llvm::CodeGenOpt::None, true, false, true, false };
+  case CodegenProfile::FastRun:
+    return { llvm::CodeGenOpt::Aggressive, false, true, false, true };
+  default:
+    return { llvm::CodeGenOpt::Default, false, false, false, false };
+  }
+}
+
+CodegenProfile mull::selectCodegenProfile(const CodegenEstimate &estimate) {
+  if (estimate.executionTime > estimate.compilationTime) {
+    return CodegenProfile::FastRun;
+  }
+  return CodegenProfile::FastCompile;
+}
+
+static std::string hostCPUFeatures() {
+  llvm::StringMap<bool> hostFeatures;
+  llvm::SubtargetFeatures features;
+  if (llvm::sys::getHostCPUFeatures(hostFeatures)) {
+    for (auto &feature : hostFeatures) {
+      features.AddFeature(feature.first(), feature.second);
+    }
+  }
+  return features.getString();
+}
+
+/// Mutated functions are clones of already optimized code, but the mutation itself often
+/// leaves something to simplify
+static void optimizeMutatedFunctions(const Bitcode &bitcode, llvm::TargetMachine *targetMachine) {
+  llvm::legacy::FunctionPassManager passManager(bitcode.getModule());
+  llvm::PassManagerBuilder builder;
+  builder.OptLevel = 2;
+  targetMachine->adjustPassManager(builder);
+  builder.populateFunctionPassManager(passManager);
+
+  std::unordered_set<llvm::Function *> mutatedFunctions;
+  for (auto &pair : bitcode.getMutationPointsMap()) {
+    for (MutationPoint *point : pair.second) {
+      if (point->getMutatedFunction()) {
+        mutatedFunctions.insert(point->getMutatedFunction());
+      }
+    }
+  }
+
+  passManager.doInitialization();
+  for (llvm::Function *function : mutatedFunctions) {
+    passManager.run(*function);
+  }
+  passManager.doFinalization();
+}
 
 static std::string tempFile(Diagnostics &diagnostics, const std::string &extension) {
   llvm::Twine prefix("mull");
@@ -31,7 +105,32 @@ static std::string tempFile(Diagnostics &diagnostics, const std::string &extensi
   return resultPath.str().str();
 }
 
+llvm::TargetMachine *Compiler::getTargetMachine(const llvm::Target &target,
+                                               const std::string &triple, const std::string &CPU,
+                                               const std::string &features,
+                                               CodegenProfile profile) {
+  std::lock_guard<std::mutex> lock(targetMachinesMutex);
+  auto key = std::make_pair(std::this_thread::get_id(),
+                            triple + ";" + CPU + ";" + features + ";" +
+                                codegenProfileName(profile));
+  auto &targetMachine = targetMachines[key];
+  if (!targetMachine) {
+    llvm::TargetOptions opt;
+    llvm::Optional<llvm::Reloc::Model> relocationModel;
+    CodegenPipeline pipeline = codegenPipeline(profile);
+    targetMachine.reset(target.createTargetMachine(
+        triple, CPU, features, opt, relocationModel, llvm::None, pipeline.optimizationLevel));
+    if (pipeline.fastInstructionSelection) {
+      targetMachine->setFastISel(true);
+    }
+  }
+  return targetMachine.get();
+}
+
 std::string Compiler::compileBitcode(const Bitcode &bitcode) {
+  MetricsMeasure setup;
+  setup.start();
+
   std::string error;
   llvm::raw_string_ostream stream(error);
   if (llvm::verifyModule(*bitcode.getModule(), &stream)) {
@@ -46,14 +145,43 @@ std::string Compiler::compileBitcode(const Bitcode &bitcode) {
     return std::string();
   }
 
-  auto CPU = "generic";
-  auto features = "";
-  llvm::TargetOptions opt;
-  llvm::Optional<llvm::Reloc::Model> relocationModel;
-  llvm::TargetMachine *targetMachine =
-      target->createTargetMachine(targetTriple, CPU, features, opt, relocationModel);
+  /// Auto is resolved by the driver, if it was not then the default profile is good enough
+  CodegenProfile profile = codegenProfile;
+  if (profile == CodegenProfile::Auto) {
+    profile = CodegenProfile::Default;
+  }
+  CodegenPipeline pipeline = codegenPipeline(profile);
+
+  std::string CPU = "generic";
+  std::string features;
+  if (pipeline.hostCPU &&
+      llvm::Triple(targetTriple).getArch() ==
+          llvm::Triple(llvm::sys::getProcessTriple()).getArch()) {
+    CPU = llvm::sys::getHostCPUName().str();
+    features = hostCPUFeatures();
+  }
 
   std::string result = tempFile(diagnostics, "o");
+  std::string cacheKey;
+  if (objectCache.isEnabled()) {
+    cacheKey =
+        objectCache.getKey(*bitcode.getModule(),
+                           CPU + ";" + features + ";" + codegenProfileName(profile));
+    if (!objectCache.getObject(cacheKey, result).empty()) {
+      return result;
+    }
+  }
+
+  llvm::TargetMachine *targetMachine =
+      getTargetMachine(*target, targetTriple, CPU, features, profile);
+
+  if (pipeline.stripDebugInfo) {
+    llvm::StripDebugInfo(*bitcode.getModule());
+  }
+  if (pipeline.optimizeMutatedFunctions) {
+    optimizeMutatedFunctions(bitcode, targetMachine);
+  }
+
   std::error_code errorCode;
   llvm::raw_fd_ostream dest(result, errorCode, llvm::sys::fs::OpenFlags::F_None);
 
@@ -67,8 +195,23 @@ std::string Compiler::compileBitcode(const Bitcode &bitcode) {
     diagnostics.error("TargetMachine can not emit object file");
     return std::string();
   }
+  setup.finish();
+
+  MetricsMeasure codegen;
+  codegen.start();
   pass.run(*bitcode.getModule());
   dest.flush();
+  codegen.finish();
+
+  std::stringstream timing;
+  timing << "Compiled " << bitcode.getModule()->getModuleIdentifier()
+         << " (setup: " << setup.duration() << MetricsMeasure::precision()
+         << ", codegen: " << codegen.duration() << MetricsMeasure::precision() << ")";
+  diagnostics.debug(timing.str());
+
+  if (objectCache.isEnabled()) {
+    objectCache.putObject(cacheKey, result);
+  }
 
   if (configuration.debugEnabled) {
     std::string bitcodePath = tempFile(diagnostics, "bc");
@@ -0,0 +1,216 @@
+#include "mull/Toolchain/ForkServer.h"
+
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Runtime/ForkServerRuntime.h"
+#include "mull/Toolchain/Spawn.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+using namespace mull;
+using namespace std::string_literals;
+
+enum class ReadStatus { Done, TimedOut, Closed };
+
+static ReadStatus readAll(int descriptor, void *buffer, size_t size, long long int timeout) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+  char *cursor = static_cast<char *>(buffer);
+  while (size != 0) {
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         deadline - std::chrono::steady_clock::now())
+                         .count();
+    if (remaining <= 0) {
+      return ReadStatus::TimedOut;
+    }
+    pollfd pollDescriptor{ descriptor, POLLIN, 0 };
+    int ready = poll(&pollDescriptor, 1, int(std::min<long long int>(remaining, INT32_MAX)));
+    if (ready < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ready == 0) {
+      return ReadStatus::TimedOut;
+    }
+    if (ready < 0) {
+      return ReadStatus::Closed;
+    }
+    ssize_t bytes = read(descriptor, cursor, size);
+    if (bytes < 0 && errno == EINTR) {
+      continue;
+    }
+    if (bytes <= 0) {
+      return ReadStatus::Closed;
+    }
+    cursor += bytes;
+    size -= bytes;
+  }
+  return ReadStatus::Done;
+}
+
+static bool writeAll(int descriptor, const void *buffer, size_t size) {
+  const char *cursor = static_cast<const char *>(buffer);
+  while (size != 0) {
+    ssize_t bytes = write(descriptor, cursor, size);
+    if (bytes < 0 && errno == EINTR) {
+      continue;
+    }
+    if (bytes <= 0) {
+      return false;
+    }
+    cursor += bytes;
+    size -= bytes;
+  }
+  return true;
+}
+
+ForkServer::ForkServer(Diagnostics &diagnostics)
+    : diagnostics(diagnostics), serverPid(-1), controlDescriptor(-1), statusDescriptor(-1) {}
+
+ForkServer::~ForkServer() {
+  stop();
+}
+
+bool ForkServer::isRunning() const {
+  return serverPid > 0;
+}
+
+bool ForkServer::start(const std::string &program, const std::vector<std::string> &arguments,
+                       long long int timeout) {
+  int control[2];
+  int status[2];
+  if (!createPipe(control)) {
+    diagnostics.warning("Cannot create fork server pipe: "s + strerror(errno));
+    return false;
+  }
+  if (!createPipe(status)) {
+    diagnostics.warning("Cannot create fork server pipe: "s + strerror(errno));
+    close(control[0]);
+    close(control[1]);
+    return false;
+  }
+  /// Everything the child needs is prepared upfront: only async-signal-safe calls after fork
+  std::vector<std::string> allArguments{ program };
+  std::copy(std::begin(arguments), std::end(arguments), std::back_inserter(allArguments));
+  std::vector<char *> argv;
+  for (auto &argument : allArguments) {
+    argv.push_back(const_cast<char *>(argument.c_str()));
+  }
+  argv.push_back(nullptr);
+
+  std::string enableServer = ForkServerEnvironmentVariable + "=1"s;
+  std::vector<char *> envp;
+  for (char **variable = environ; *variable != nullptr; variable++) {
+    envp.push_back(*variable);
+  }
+  envp.push_back(const_cast<char *>(enableServer.c_str()));
+  envp.push_back(nullptr);
+
+  pid_t pid = forkProcess();
+  if (pid < 0) {
+    diagnostics.warning("Cannot fork: "s + strerror(errno));
+    for (int descriptor : { control[0], control[1], status[0], status[1] }) {
+      close(descriptor);
+    }
+    return false;
+  }
+
+  if (pid == 0) {
+    dup2(control[0], ForkServerControlDescriptor);
+    dup2(status[1], ForkServerStatusDescriptor);
+    int devNull = open("/dev/null", O_RDWR);
+    if (devNull >= 0) {
+      dup2(devNull, STDIN_FILENO);
+      dup2(devNull, STDOUT_FILENO);
+      dup2(devNull, STDERR_FILENO);
+    }
+    /// Mull ignores SIGPIPE, the ignored signals survive exec
+    signal(SIGPIPE, SIG_DFL);
+    execve(argv.front(), argv.data(), envp.data());
+    _exit(127);
+  }
+
+  close(control[0]);
+  close(status[1]);
+  serverPid = pid;
+  controlDescriptor = control[1];
+  statusDescriptor = status[0];
+
+  int hello = 0;
+  if (readAll(statusDescriptor, &hello, sizeof(hello), timeout) != ReadStatus::Done ||
+      hello != ForkServerHello) {
+    diagnostics.debug("Fork server did not respond: "s + program);
+    stop();
+    return false;
+  }
+
+  return true;
+}
+
+bool ForkServer::runMutant(const std::string &identifier, long long int timeout,
+                           ExecutionResult &result) {
+  if (!isRunning() || identifier.empty() || identifier.size() >= ForkServerMaxIdentifierLength) {
+    return false;
+  }
+
+  auto start = std::chrono::high_resolution_clock::now();
+
+  int32_t length = identifier.size();
+  if (!writeAll(controlDescriptor, &length, sizeof(length)) ||
+      !writeAll(controlDescriptor, identifier.data(), identifier.size())) {
+    stop();
+    return false;
+  }
+
+  int32_t childPid = 0;
+  if (readAll(statusDescriptor, &childPid, sizeof(childPid), timeout) != ReadStatus::Done) {
+    stop();
+    return false;
+  }
+
+  int32_t waitStatus = 0;
+  ExecutionStatus executionStatus = Failed;
+  ReadStatus readStatus = readAll(statusDescriptor, &waitStatus, sizeof(waitStatus), timeout);
+  if (readStatus == ReadStatus::TimedOut) {
+    kill(childPid, SIGKILL);
+    /// The server reaps the child and reports its status as usual
+    readStatus = readAll(statusDescriptor, &waitStatus, sizeof(waitStatus), timeout);
+    executionStatus = Timedout;
+  } else if (WIFEXITED(waitStatus) && WEXITSTATUS(waitStatus) == 0) {
+    executionStatus = Passed;
+  }
+
+  if (readStatus != ReadStatus::Done) {
+    stop();
+    return false;
+  }
+
+  auto elapsed = std::chrono::high_resolution_clock::now() - start;
+  result.runningTime = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+  result.exitStatus = WIFEXITED(waitStatus) ? WEXITSTATUS(waitStatus) : waitStatus;
+  result.status = executionStatus;
+  return true;
+}
+
+void ForkServer::stop() {
+  if (controlDescriptor >= 0) {
+    close(controlDescriptor);
+    controlDescriptor = -1;
+  }
+  if (statusDescriptor >= 0) {
+    close(statusDescriptor);
+    statusDescriptor = -1;
+  }
+  if (serverPid > 0) {
+    kill(serverPid, SIGKILL);
+    waitpid(serverPid, nullptr, 0);
+    serverPid = -1;
+  }
+}
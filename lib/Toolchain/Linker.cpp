@@ -7,6 +7,22 @@
 #include <llvm/Support/FileSystem.h>
 #include <sstream>
 
+#ifdef MULL_IN_PROCESS_LINKER
+#include <clang/Basic/Diagnostic.h>
+#include <clang/Basic/DiagnosticOptions.h>
+#include <clang/Driver/Action.h>
+#include <clang/Driver/Compilation.h>
+#include <clang/Driver/Driver.h>
+#include <clang/Driver/Job.h>
+#include <clang/Driver/ToolChain.h>
+#include <lld/Common/Driver.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/Program.h>
+#include <llvm/Support/raw_ostream.h>
+#endif
+
 using namespace mull;
 using namespace std::string_literals;
 
@@ -29,6 +45,11 @@ Linker::Linker(const Configuration &configuration, Diagnostics &diagnostics)
 
 std::string Linker::linkObjectFiles(const std::vector<std::string> &objects) {
   std::string outputFile = outputFileName(configuration, diagnostics);
+  if (configuration.inProcessLinker) {
+    if (linkInProcess(objects, outputFile)) {
+      return outputFile;
+    }
+  }
   Runner runner(diagnostics);
   std::vector<std::string> arguments;
   std::copy(std::begin(configuration.linkerFlags),
@@ -59,3 +80,105 @@ std::string Linker::linkObjectFiles(const std::vector<std::string> &objects) {
   diagnostics.debug("Link command: "s + command);
   return outputFile;
 }
+
+#ifdef MULL_IN_PROCESS_LINKER
+/// ld.lld understands the flags of the other ELF linkers
+static bool isLinkerCompatible(const std::string &linker) {
+  llvm::StringRef name = llvm::sys::path::filename(linker);
+  return name == "ld" || name.startswith("ld.");
+}
+
+/// The flags of a compiler driver (e.g. -lstdc++ or -fsanitize=address) mean nothing to lld,
+/// and the driver adds the startup files and the default libraries on its own. The arguments
+/// of its link job are what lld needs instead.
+static bool translateDriverArguments(const std::string &driverPath,
+                                     const std::vector<std::string> &driverArguments,
+                                     std::vector<std::string> &linkerArguments) {
+  llvm::IntrusiveRefCntPtr<clang::DiagnosticIDs> diagnosticIDs(new clang::DiagnosticIDs);
+  llvm::IntrusiveRefCntPtr<clang::DiagnosticOptions> diagnosticOptions(
+      new clang::DiagnosticOptions);
+  clang::DiagnosticsEngine engine(
+      diagnosticIDs, diagnosticOptions, new clang::IgnoringDiagConsumer);
+  clang::driver::Driver driver(driverPath, llvm::sys::getDefaultTargetTriple(), engine);
+
+  std::vector<const char *> arguments({ driverPath.c_str() });
+  for (auto &argument : driverArguments) {
+    arguments.push_back(argument.c_str());
+  }
+  std::unique_ptr<clang::driver::Compilation> compilation(driver.BuildCompilation(arguments));
+  if (!compilation || compilation->containsError() ||
+      !compilation->getDefaultToolChain().getTriple().isOSBinFormatELF()) {
+    return false;
+  }
+  for (const clang::driver::Command &job : compilation->getJobs()) {
+    if (llvm::isa<clang::driver::LinkJobAction>(job.getSource())) {
+      for (const char *argument : job.getArguments()) {
+        linkerArguments.emplace_back(argument);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+#endif
+
+bool Linker::linkInProcess(const std::vector<std::string> &objects,
+                           const std::string &outputFile) {
+#ifdef MULL_IN_PROCESS_LINKER
+  std::vector<std::string> linkArguments;
+  std::copy(std::begin(configuration.linkerFlags),
+            std::end(configuration.linkerFlags),
+            std::back_inserter(linkArguments));
+  std::copy(std::begin(objects), std::end(objects), std::back_inserter(linkArguments));
+  linkArguments.emplace_back("-o");
+  linkArguments.push_back(outputFile);
+
+  std::vector<std::string> lldArguments;
+  if (isLinkerCompatible(configuration.linker)) {
+    lldArguments = linkArguments;
+  } else {
+    std::string driverPath = configuration.linker;
+    if (auto path = llvm::sys::findProgramByName(configuration.linker)) {
+      driverPath = path.get();
+    }
+    if (!translateDriverArguments(driverPath, linkArguments, lldArguments)) {
+      diagnostics.warning("Cannot translate the linker flags for lld, falling back to "s +
+                          configuration.linker);
+      return false;
+    }
+  }
+
+  std::vector<const char *> arguments({ "ld.lld" });
+  for (auto &argument : lldArguments) {
+    arguments.push_back(argument.c_str());
+  }
+
+  std::string output;
+  llvm::raw_string_ostream outputStream(output);
+  /// lld must not exit the process on errors, we want to report them
+  bool canExitEarly = false;
+#if LLVM_VERSION_MAJOR >= 10
+  bool linked = lld::elf::link(arguments, canExitEarly, outputStream, outputStream);
+#else
+  bool linked = lld::elf::link(arguments, canExitEarly, outputStream);
+#endif
+  outputStream.flush();
+
+  std::stringstream commandStream;
+  for (auto &argument : arguments) {
+    commandStream << argument << ' ';
+  }
+  if (!linked) {
+    std::stringstream message;
+    message << "Cannot link program\n";
+    message << "command: " << commandStream.str() << "\n";
+    message << "output: " << output << "\n";
+    diagnostics.error(message.str());
+  }
+  diagnostics.debug("In-process link command: "s + commandStream.str());
+  return true;
+#else
+  diagnostics.warning("Mull is built without lld, falling back to "s + configuration.linker);
+  return false;
+#endif
+}
@@ -0,0 +1,82 @@
+#include "mull/Toolchain/ObjectCache.h"
+
+#include "LLVMCompatibility.h"
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Hashing.h"
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/Process.h>
+#include <llvm/Support/raw_ostream.h>
+
+using namespace mull;
+using namespace std::string_literals;
+
+ObjectCache::ObjectCache(Diagnostics &diagnostics, std::string directory)
+    : diagnostics(diagnostics), directory(std::move(directory)) {
+  if (this->directory.empty()) {
+    return;
+  }
+  if (std::error_code error = llvm::sys::fs::create_directories(this->directory)) {
+    diagnostics.warning("Cannot create cache directory "s + this->directory + ": " +
+                        error.message());
+    this->directory.clear();
+  }
+}
+
+bool ObjectCache::isEnabled() const {
+  return !directory.empty();
+}
+
+std::string ObjectCache::getKey(const llvm::Module &module, const std::string &options) const {
+  llvm::SmallString<0> buffer;
+  llvm::raw_svector_ostream stream(buffer);
+  llvm_compat::writeBitcodeToFile(module, stream);
+
+  llvm::MD5 hash;
+  hash.update(buffer.str());
+  hash.update(module.getTargetTriple());
+  hash.update(options);
+  return hexDigest(hash);
+}
+
+std::string ObjectCache::getObjectPath(const std::string &key) const {
+  llvm::SmallString<128> path(directory);
+  llvm::sys::path::append(path, key + ".o");
+  return path.str().str();
+}
+
+std::string ObjectCache::getObject(const std::string &key, const std::string &destination) const {
+  std::string cachedObject = getObjectPath(key);
+  if (!llvm::sys::fs::exists(cachedObject)) {
+    return std::string();
+  }
+  /// The callers may remove the object file once they are done with it, so they get a copy
+  if (std::error_code error = llvm::sys::fs::copy_file(cachedObject, destination)) {
+    diagnostics.warning("Cannot copy cached object file "s + cachedObject + ": " +
+                        error.message());
+    return std::string();
+  }
+  diagnostics.debug("Reusing cached object file: "s + cachedObject);
+  return destination;
+}
+
+void ObjectCache::putObject(const std::string &key, const std::string &objectFile) const {
+  std::string cachedObject = getObjectPath(key);
+  /// Several workers (or several Mull instances) may store the same object concurrently:
+  /// the object is copied to a unique file first and then atomically renamed
+  llvm::SmallString<128> temporaryObject;
+  int descriptor;
+  if (llvm::sys::fs::createUniqueFile(cachedObject + ".%%%%%%", descriptor, temporaryObject)) {
+    return;
+  }
+  llvm::sys::Process::SafelyCloseFileDescriptor(descriptor);
+  if (llvm::sys::fs::copy_file(objectFile, temporaryObject) ||
+      llvm::sys::fs::rename(temporaryObject, cachedObject)) {
+    diagnostics.warning("Cannot store object file in cache: "s + cachedObject);
+    llvm::sys::fs::remove(temporaryObject);
+  }
+}
@@ -27,16 +27,17 @@ static std::pair<std::string, std::string> drainProcess(reproc::process &process
 
 Runner::Runner(Diagnostics &diagnostics) : diagnostics(diagnostics) {}
 
-ExecutionResult Runner::runProgram(const std::string &program,
-                                   const std::vector<std::string> &arguments,
-                                   const std::vector<std::string> &environment,
-                                   long long int timeout, bool captureOutput,
-                                   std::optional<std::string> optionalWorkingDirectory) {
+ExecutionResult
+Runner::runProgram(const std::string &program, const std::vector<std::string> &arguments,
+                   const std::vector<std::string> &environment, long long int timeout,
+                   bool captureOutput, std::optional<std::string> optionalWorkingDirectory,
+                   const std::vector<std::pair<std::string, std::string>> &environmentValues) {
   std::vector<std::pair<std::string, std::string>> env;
-  env.reserve(environment.size());
+  env.reserve(environment.size() + environmentValues.size());
   for (auto &e : environment) {
     env.emplace_back(e, "1");
   }
+  env.insert(env.end(), environmentValues.begin(), environmentValues.end());
 
   reproc::options options;
   options.env.extra = reproc::env(env);
@@ -0,0 +1,36 @@
+#include "mull/Toolchain/Spawn.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined __APPLE__
+#include <mutex>
+
+/// There is no pipe2 on macOS: a pipe is marked close-on-exec after it is created,
+/// so no process may be forked in between
+static std::mutex &spawnMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+#endif
+
+bool mull::createPipe(int descriptors[2]) {
+#if defined __APPLE__
+  std::lock_guard<std::mutex> lock(spawnMutex());
+  if (pipe(descriptors) != 0) {
+    return false;
+  }
+  fcntl(descriptors[0], F_SETFD, FD_CLOEXEC);
+  fcntl(descriptors[1], F_SETFD, FD_CLOEXEC);
+  return true;
+#else
+  return pipe2(descriptors, O_CLOEXEC) == 0;
+#endif
+}
+
+pid_t mull::forkProcess() {
+#if defined __APPLE__
+  std::lock_guard<std::mutex> lock(spawnMutex());
+#endif
+  return fork();
+}
@@ -0,0 +1,192 @@
+#include "mull/Toolchain/TestFramework.h"
+#include "mull/Toolchain/Runner.h"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace mull;
+
+static std::string trim(const std::string &string) {
+  auto begin = string.find_first_not_of(" \t\r");
+  if (begin == std::string::npos) {
+    return "";
+  }
+  auto end = string.find_last_not_of(" \t\r");
+  return string.substr(begin, end - begin + 1);
+}
+
+static std::string join(const std::vector<std::string> &strings, char separator) {
+  std::string result;
+  for (auto &string : strings) {
+    if (!result.empty()) {
+      result += separator;
+    }
+    result += string;
+  }
+  return result;
+}
+
+/// Parameterized tests are listed as 'Name  # GetParam() = 42'
+static std::string stripGoogleTestComment(const std::string &line) {
+  return trim(line.substr(0, line.find('#')));
+}
+
+/// The listing starts with the suite name followed by the indented test names:
+///
+///   Suite.
+///     Test
+///     Parameterized/0  # GetParam() = 42
+static std::vector<std::string> parseGoogleTestList(const std::string &output) {
+  std::vector<std::string> tests;
+  std::istringstream stream(output);
+  std::string line;
+  std::string suite;
+  while (std::getline(stream, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    std::string name = stripGoogleTestComment(line);
+    if (line.front() != ' ') {
+      /// Anything else is printed by the program itself, e.g. 'Running main() from gtest_main.cc'
+      suite = !name.empty() && name.back() == '.' ? name : "";
+    } else if (!suite.empty() && !name.empty()) {
+      tests.push_back(suite + name);
+    }
+  }
+  return tests;
+}
+
+/// One name per line, the names starting with '#' are quoted
+static std::vector<std::string> parseCatch2List(const std::string &output) {
+  std::vector<std::string> tests;
+  std::istringstream stream(output);
+  std::string line;
+  while (std::getline(stream, line)) {
+    if (trim(line).empty()) {
+      continue;
+    }
+    if (line.size() > 2 && line.compare(0, 2, "\"#") == 0 && line.back() == '"') {
+      line = line.substr(1, line.size() - 2);
+    }
+    tests.push_back(line);
+  }
+  return tests;
+}
+
+/// The names are surrounded by the separators and the doctest's own messages:
+///
+///   [doctest] listing all test case names
+///   ================================================
+///   Test
+///   ================================================
+///   [doctest] unskipped test cases passing the current filters: 1
+static std::vector<std::string> parseDoctestList(const std::string &output) {
+  std::vector<std::string> tests;
+  std::istringstream stream(output);
+  std::string line;
+  while (std::getline(stream, line)) {
+    std::string name = trim(line);
+    if (name.empty() || name.compare(0, 9, "[doctest]") == 0 ||
+        name.find_first_not_of('=') == std::string::npos) {
+      continue;
+    }
+    tests.push_back(name);
+  }
+  return tests;
+}
+
+/// Commas separate the names, brackets select tags, and '*' is a wildcard
+static std::string escapeCatch2Name(const std::string &name) {
+  std::string escaped;
+  for (char c : name) {
+    if (c == '\\' || c == ',' || c == '[' || c == ']' || c == '*') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  if (!escaped.empty() && escaped.front() == '~') {
+    escaped.insert(0, "\\");
+  }
+  return escaped;
+}
+
+/// Commas separate the filters and cannot be escaped in all versions of doctest,
+/// a single character wildcard matches them instead
+static std::string escapeDoctestName(const std::string &name) {
+  std::string escaped(name);
+  std::replace(escaped.begin(), escaped.end(), ',', '?');
+  return escaped;
+}
+
+TestFramework::TestFramework(TestFrameworkKind kind) : kind(kind) {}
+
+std::vector<std::vector<std::string>> TestFramework::listArguments() const {
+  switch (kind) {
+  case TestFrameworkKind::GoogleTest:
+    return { { "--gtest_list_tests" } };
+  case TestFrameworkKind::Catch2:
+    /// Catch2 v3 rejects the option of v2, and v2 would decorate the listing of v3
+    return { { "--list-test-names-only" }, { "--list-tests", "--verbosity", "quiet" } };
+  case TestFrameworkKind::Doctest:
+    return { { "--list-test-cases" } };
+  case TestFrameworkKind::None:
+    break;
+  }
+  return {};
+}
+
+std::vector<std::string> TestFramework::listTests(Runner &runner, const std::string &executable,
+                                                  const std::vector<std::string> &extraArgs,
+                                                  long long timeout) const {
+  for (auto &listing : listArguments()) {
+    std::vector<std::string> arguments(extraArgs);
+    arguments.insert(arguments.end(), listing.begin(), listing.end());
+    ExecutionResult result =
+        runner.runProgram(executable, arguments, {}, timeout, true, std::nullopt);
+    /// Catch2 v2 exits with the number of the listed tests
+    if (result.status != Passed && result.status != Failed) {
+      continue;
+    }
+    std::vector<std::string> tests = parseTestList(result.stdoutOutput);
+    if (!tests.empty()) {
+      return tests;
+    }
+  }
+  return {};
+}
+
+std::vector<std::string> TestFramework::parseTestList(const std::string &output) const {
+  switch (kind) {
+  case TestFrameworkKind::GoogleTest:
+    return parseGoogleTestList(output);
+  case TestFrameworkKind::Catch2:
+    return parseCatch2List(output);
+  case TestFrameworkKind::Doctest:
+    return parseDoctestList(output);
+  case TestFrameworkKind::None:
+    break;
+  }
+  return {};
+}
+
+std::vector<std::string>
+TestFramework::selectArguments(const std::vector<std::string> &tests) const {
+  std::vector<std::string> escaped;
+  switch (kind) {
+  case TestFrameworkKind::GoogleTest:
+    return { "--gtest_filter=" + join(tests, ':') };
+  case TestFrameworkKind::Catch2:
+    for (auto &test : tests) {
+      escaped.push_back(escapeCatch2Name(test));
+    }
+    return { join(escaped, ',') };
+  case TestFrameworkKind::Doctest:
+    for (auto &test : tests) {
+      escaped.push_back(escapeDoctestName(test));
+    }
+    return { "--test-case=" + join(escaped, ',') };
+  case TestFrameworkKind::None:
+    break;
+  }
+  return {};
+}
@@ -0,0 +1,119 @@
+#include "mull/Toolchain/Worker.h"
+
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Toolchain/Spawn.h"
+#include "mull/Toolchain/WorkerProtocol.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace mull;
+using namespace std::string_literals;
+
+/// On top of the timeouts: the transport (e.g. ssh) may add its own delays
+static const long long int WorkerLatencyAllowance = 10000;
+
+Worker::Worker(Diagnostics &diagnostics)
+    : diagnostics(diagnostics), workerPid(-1), requestDescriptor(-1), resultDescriptor(-1) {}
+
+Worker::~Worker() {
+  stop();
+}
+
+bool Worker::isRunning() const {
+  return workerPid > 0;
+}
+
+bool Worker::start(const std::string &workerCommand, const std::string &executable,
+                   bool captureOutput, long long int timeout) {
+  command = workerCommand;
+  int requests[2];
+  int results[2];
+  if (!createPipe(requests)) {
+    diagnostics.warning("Cannot create worker pipe: "s + strerror(errno));
+    return false;
+  }
+  if (!createPipe(results)) {
+    diagnostics.warning("Cannot create worker pipe: "s + strerror(errno));
+    close(requests[0]);
+    close(requests[1]);
+    return false;
+  }
+  pid_t pid = forkProcess();
+  if (pid < 0) {
+    diagnostics.warning("Cannot fork: "s + strerror(errno));
+    for (int descriptor : { requests[0], requests[1], results[0], results[1] }) {
+      close(descriptor);
+    }
+    return false;
+  }
+
+  if (pid == 0) {
+    dup2(requests[0], STDIN_FILENO);
+    dup2(results[1], STDOUT_FILENO);
+    /// Mull ignores SIGPIPE, the ignored signals survive exec
+    signal(SIGPIPE, SIG_DFL);
+    execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char *>(nullptr));
+    _exit(127);
+  }
+
+  close(requests[0]);
+  close(results[1]);
+  workerPid = pid;
+  requestDescriptor = requests[1];
+  resultDescriptor = results[0];
+
+  WorkerFrame hello;
+  if (!readWorkerFrame(resultDescriptor, hello, timeout + WorkerLatencyAllowance) ||
+      hello.size() != 2 || hello[0] != "hello" || hello[1] != WorkerProtocolVersion) {
+    diagnostics.warning("Worker did not respond: " + command);
+    stop();
+    return false;
+  }
+  if (!writeWorkerFrame(requestDescriptor, { "program", executable, captureOutput ? "1" : "0" })) {
+    diagnostics.warning("Worker is gone: " + command);
+    stop();
+    return false;
+  }
+  return true;
+}
+
+bool Worker::runMutant(const std::string &identifier, const std::vector<std::string> &arguments,
+                       long long int timeout, ExecutionResult &result) {
+  if (!isRunning()) {
+    return false;
+  }
+
+  WorkerFrame request({ "run", identifier, std::to_string(timeout) });
+  request.insert(request.end(), arguments.begin(), arguments.end());
+  WorkerFrame response;
+  std::string mutant;
+  if (!writeWorkerFrame(requestDescriptor, request) ||
+      !readWorkerFrame(resultDescriptor, response, timeout + WorkerLatencyAllowance) ||
+      !parseResultFrame(response, mutant, result) || mutant != identifier) {
+    diagnostics.warning("Worker stopped responding, running the mutants locally: " + command);
+    stop();
+    return false;
+  }
+  return true;
+}
+
+void Worker::stop() {
+  if (requestDescriptor >= 0) {
+    close(requestDescriptor);
+    requestDescriptor = -1;
+  }
+  if (resultDescriptor >= 0) {
+    close(resultDescriptor);
+    resultDescriptor = -1;
+  }
+  if (workerPid > 0) {
+    /// The worker may be stuck in a mutant, its results are not needed anymore
+    kill(workerPid, SIGTERM);
+    waitpid(workerPid, nullptr, 0);
+    workerPid = -1;
+  }
+}
@@ -0,0 +1,189 @@
+#include "mull/Toolchain/WorkerProtocol.h"
+
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Toolchain/Runner.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <poll.h>
+#include <unistd.h>
+
+using namespace mull;
+
+const char *mull::WorkerProtocolVersion = "1";
+
+/// Guards against reading garbage as a length, e.g. when the worker prints to stdout
+static const uint32_t MaxFrameSize = 1u << 30;
+
+static void appendLength(std::string &buffer, uint32_t length) {
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    buffer.push_back(char((length >> shift) & 0xff));
+  }
+}
+
+static uint32_t readLength(const char *bytes) {
+  uint32_t length = 0;
+  for (int i = 0; i < 4; i++) {
+    length = (length << 8) | uint8_t(bytes[i]);
+  }
+  return length;
+}
+
+static bool readAll(int descriptor, char *buffer, size_t size, long long int timeout) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+  while (size != 0) {
+    int pollTimeout = -1;
+    if (timeout >= 0) {
+      auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           deadline - std::chrono::steady_clock::now())
+                           .count();
+      if (remaining <= 0) {
+        return false;
+      }
+      pollTimeout = int(std::min<long long int>(remaining, INT32_MAX));
+    }
+    pollfd pollDescriptor{ descriptor, POLLIN, 0 };
+    int ready = poll(&pollDescriptor, 1, pollTimeout);
+    if (ready < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ready <= 0) {
+      return false;
+    }
+    ssize_t bytes = read(descriptor, buffer, size);
+    if (bytes < 0 && errno == EINTR) {
+      continue;
+    }
+    if (bytes <= 0) {
+      return false;
+    }
+    buffer += bytes;
+    size -= bytes;
+  }
+  return true;
+}
+
+static bool writeAll(int descriptor, const char *buffer, size_t size) {
+  while (size != 0) {
+    ssize_t bytes = write(descriptor, buffer, size);
+    if (bytes < 0 && errno == EINTR) {
+      continue;
+    }
+    if (bytes <= 0) {
+      return false;
+    }
+    buffer += bytes;
+    size -= bytes;
+  }
+  return true;
+}
+
+std::string mull::encodeWorkerFrame(const WorkerFrame &frame) {
+  std::string payload;
+  for (auto &field : frame) {
+    appendLength(payload, uint32_t(field.size()));
+    payload += field;
+  }
+  std::string buffer;
+  appendLength(buffer, uint32_t(payload.size()));
+  return buffer + payload;
+}
+
+bool mull::decodeWorkerFrame(const std::string &payload, WorkerFrame &frame) {
+  frame.clear();
+  size_t offset = 0;
+  while (offset != payload.size()) {
+    if (payload.size() - offset < 4) {
+      return false;
+    }
+    uint32_t length = readLength(payload.data() + offset);
+    offset += 4;
+    if (payload.size() - offset < length) {
+      return false;
+    }
+    frame.push_back(payload.substr(offset, length));
+    offset += length;
+  }
+  return true;
+}
+
+bool mull::readWorkerFrame(int descriptor, WorkerFrame &frame, long long int timeout) {
+  char header[4];
+  if (!readAll(descriptor, header, sizeof(header), timeout)) {
+    return false;
+  }
+  uint32_t length = readLength(header);
+  if (length > MaxFrameSize) {
+    return false;
+  }
+  std::string payload(length, '\0');
+  if (!readAll(descriptor, &payload[0], length, timeout)) {
+    return false;
+  }
+  return decodeWorkerFrame(payload, frame);
+}
+
+bool mull::writeWorkerFrame(int descriptor, const WorkerFrame &frame) {
+  std::string buffer = encodeWorkerFrame(frame);
+  return writeAll(descriptor, buffer.data(), buffer.size());
+}
+
+WorkerFrame mull::makeResultFrame(const std::string &mutant, const ExecutionResult &result) {
+  return { "result",
+           mutant,
+           std::to_string(result.status),
+           std::to_string(result.exitStatus),
+           std::to_string(result.runningTime),
+           result.stdoutOutput,
+           result.stderrOutput };
+}
+
+bool mull::parseResultFrame(const WorkerFrame &frame, std::string &mutant,
+                            ExecutionResult &result) {
+  if (frame.size() != 7 || frame[0] != "result") {
+    return false;
+  }
+  try {
+    mutant = frame[1];
+    result.status = ExecutionStatus(std::stoi(frame[2]));
+    result.exitStatus = std::stoi(frame[3]);
+    result.runningTime = std::stoll(frame[4]);
+  } catch (std::logic_error &) {
+    return false;
+  }
+  result.stdoutOutput = frame[5];
+  result.stderrOutput = frame[6];
+  return true;
+}
+
+void mull::serveWorkerRequests(Diagnostics &diagnostics, int input, int output) {
+  if (!writeWorkerFrame(output, { "hello", WorkerProtocolVersion })) {
+    return;
+  }
+
+  Runner runner(diagnostics);
+  std::string executable;
+  bool captureOutput = true;
+  WorkerFrame frame;
+  while (readWorkerFrame(input, frame, -1)) {
+    if (frame.size() == 3 && frame[0] == "program") {
+      executable = frame[1];
+      captureOutput = frame[2] == "1";
+      continue;
+    }
+    if (frame.size() < 3 || frame[0] != "run" || executable.empty()) {
+      diagnostics.warning("Unexpected worker request: " + (frame.empty() ? "" : frame[0]));
+      return;
+    }
+    long long int timeout = std::strtoll(frame[2].c_str(), nullptr, 10);
+    std::vector<std::string> arguments(frame.begin() + 3, frame.end());
+    ExecutionResult result = runner.runProgram(
+        executable, arguments, { frame[1] }, timeout, captureOutput, std::nullopt);
+    if (!writeWorkerFrame(output, makeResultFrame(frame[1], result))) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,35 @@
+int sum(int a, int b) {
+  return a + b;
+}
+
+int product(int a, int b) {
+  return a * b;
+}
+
+int main() {
+  if (sum(2, 5) != 7) {
+    return 1;
+  }
+  product(2, 5);
+  return 0;
+}
+
+// clang-format off
+
+// RUN: cd / && %clang_cc %s -fembed-bitcode -g -o %s.exe
+// RUN: cd %CURRENT_DIR
+// RUN: unset TERM; %mull_cxx -linker=%clang_cc -fork-server -ide-reporter-show-killed -mutators=cxx_add_to_sub -mutators=cxx_mul_to_div -reporters=IDE %s.exe | %FILECHECK_EXEC %s --dump-input=fail --match-full-lines
+// CHECK-NOT: [warning] Cannot start fork server{{.*}}
+// CHECK: [info] Killed mutants (1/2):
+// CHECK: {{.*}}/main.c:2:12: warning: Killed: Replaced + with - [cxx_add_to_sub]
+// CHECK: [info] Survived mutants (1/2):
+// CHECK: {{.*}}/main.c:6:12: warning: Survived: Replaced * with / [cxx_mul_to_div]
+// CHECK: [info] Mutation score: 50%
+
+// RUN: unset TERM; %mull_cxx -linker=%clang_cc -fork-server -keep-executable -mutate-only -output=%s.mutated.exe -mutators=cxx_add_to_sub -mutators=cxx_mul_to_div %s.exe
+// RUN: unset TERM; %mull_runner %s.mutated.exe -fork-server -ide-reporter-show-killed | %FILECHECK_EXEC %s --dump-input=fail --match-full-lines --check-prefix=CHECK-RUNNER
+// CHECK-RUNNER-NOT: [warning] Cannot start fork server{{.*}}
+// CHECK-RUNNER: [info] Killed mutants (1/2):
+// CHECK-RUNNER: {{.*}}/main.c:2:12: warning: Killed: Replaced + with - [cxx_add_to_sub]
+// CHECK-RUNNER: [info] Survived mutants (1/2):
+// CHECK-RUNNER: {{.*}}/main.c:6:12: warning: Survived: Replaced * with / [cxx_mul_to_div]
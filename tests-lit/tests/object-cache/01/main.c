@@ -0,0 +1,23 @@
+int sum(int a, int b) {
+  return a + b;
+}
+
+int main() {
+  if (sum(2, 5) != 7) {
+    return 1;
+  }
+  return 0;
+}
+
+// clang-format off
+
+// RUN: cd / && %clang_cc %s -fembed-bitcode -g -o %s.exe
+// RUN: cd %CURRENT_DIR
+// RUN: rm -rf %s.cache
+// RUN: unset TERM; %mull_cxx -linker=%clang_cc -debug -cache-dir=%s.cache -mutators=cxx_add_to_sub -reporters=IDE %s.exe | %FILECHECK_EXEC %s --dump-input=fail --check-prefix=CHECK-COLD
+// CHECK-COLD-NOT: [debug] Reusing cached object file{{.*}}
+// CHECK-COLD: [info] Mutation score: 100%
+
+// RUN: unset TERM; %mull_cxx -linker=%clang_cc -debug -cache-dir=%s.cache -mutators=cxx_add_to_sub -reporters=IDE %s.exe | %FILECHECK_EXEC %s --dump-input=fail --check-prefix=CHECK-WARM
+// CHECK-WARM: [debug] Reusing cached object file: {{.*}}.cache/{{.*}}.o
+// CHECK-WARM: [info] Mutation score: 100%
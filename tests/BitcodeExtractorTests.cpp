@@ -0,0 +1,57 @@
+#include "FixturePaths.h"
+#include "mull/BitcodeExtractor.h"
+#include "mull/Diagnostics/Diagnostics.h"
+
+#include <ebc/BitcodeContainer.h>
+#include <ebc/BitcodeRetriever.h>
+#include <ebc/EmbeddedFile.h>
+#include <gtest/gtest.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include <algorithm>
+
+using namespace mull;
+
+static std::vector<std::string> sourceFileNames(const std::vector<llvm::MemoryBufferRef> &buffers) {
+  std::vector<std::string> names;
+  for (auto &buffer : buffers) {
+    llvm::LLVMContext context;
+    auto module = llvm::parseBitcodeFile(buffer, context);
+    if (!module) {
+      ADD_FAILURE() << llvm::toString(module.takeError());
+      continue;
+    }
+    names.push_back(module.get()->getSourceFileName());
+  }
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+TEST(BitcodeExtractor, SplitsConcatenatedModules) {
+  Diagnostics diagnostics;
+  const char *executable = fixtures::embedded_bitcode_program_exe_path();
+
+  BitcodeExtractor extractor(diagnostics);
+  std::vector<std::string> extracted = sourceFileNames(extractor.extractBitcode(executable));
+
+  std::vector<std::unique_ptr<ebc::EmbeddedFile>> embeddedFiles;
+  ebc::BitcodeRetriever bitcodeRetriever(executable);
+  for (auto &bitcodeInfo : bitcodeRetriever.GetBitcodeInfo()) {
+    if (bitcodeInfo.bitcodeContainer) {
+      for (auto &file : bitcodeInfo.bitcodeContainer->GetRawEmbeddedFiles()) {
+        embeddedFiles.push_back(std::move(file));
+      }
+    }
+  }
+  std::vector<llvm::MemoryBufferRef> ebcBuffers;
+  for (auto &file : embeddedFiles) {
+    auto pair = file->GetRawBuffer();
+    ebcBuffers.emplace_back(llvm::StringRef(pair.first, pair.second), "");
+  }
+  std::vector<std::string> retrieved = sourceFileNames(ebcBuffers);
+
+  ASSERT_EQ(extracted.size(), 3U);
+  ASSERT_EQ(extracted, retrieved);
+}
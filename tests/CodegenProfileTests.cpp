@@ -0,0 +1,132 @@
+#include "mull/Bitcode.h"
+#include "mull/Config/Configuration.h"
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/MutationPoint.h"
+#include "mull/Mutators/NegateConditionMutator.h"
+#include "mull/Toolchain/Compiler.h"
+
+#include <gtest/gtest.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/TargetSelect.h>
+
+using namespace mull;
+
+TEST(CodegenProfile, ParsesProfileNames) {
+  for (CodegenProfile profile : { CodegenProfile::Default,
+                                  CodegenProfile::FastCompile,
+                                  CodegenProfile::FastRun,
+                                  CodegenProfile::Auto }) {
+    CodegenProfile parsed = CodegenProfile::Default;
+    ASSERT_TRUE(parseCodegenProfile(codegenProfileName(profile), parsed));
+    ASSERT_EQ(parsed, profile);
+  }
+  ASSERT_EQ(codegenProfileName(CodegenProfile::FastCompile), "fast-compile");
+
+  CodegenProfile profile = CodegenProfile::FastRun;
+  ASSERT_FALSE(parseCodegenProfile("fast", profile));
+  ASSERT_FALSE(parseCodegenProfile("", profile));
+  ASSERT_EQ(profile, CodegenProfile::FastRun);
+}
+
+TEST(CodegenProfile, SelectsProfileByEstimatedTimes) {
+  ASSERT_EQ(selectCodegenProfile({ 100, 1000 }), CodegenProfile::FastRun);
+  ASSERT_EQ(selectCodegenProfile({ 1000, 100 }), CodegenProfile::FastCompile);
+  ASSERT_EQ(selectCodegenProfile({ 100, 100 }), CodegenProfile::FastCompile);
+  /// The sanity check run is skipped
+  ASSERT_EQ(selectCodegenProfile({ 0, -1 }), CodegenProfile::FastCompile);
+}
+
+TEST(CodegenProfile, DescribesPipelineOfEachProfile) {
+  CodegenPipeline fastCompile = codegenPipeline(CodegenProfile::FastCompile);
+  ASSERT_EQ(fastCompile.optimizationLevel, llvm::CodeGenOpt::None);
+  ASSERT_TRUE(fastCompile.fastInstructionSelection);
+  ASSERT_FALSE(fastCompile.hostCPU);
+  ASSERT_TRUE(fastCompile.stripDebugInfo);
+  ASSERT_FALSE(fastCompile.optimizeMutatedFunctions);
+
+  CodegenPipeline fastRun = codegenPipeline(CodegenProfile::FastRun);
+  ASSERT_EQ(fastRun.optimizationLevel, llvm::CodeGenOpt::Aggressive);
+  ASSERT_FALSE(fastRun.fastInstructionSelection);
+  ASSERT_TRUE(fastRun.hostCPU);
+  ASSERT_FALSE(fastRun.stripDebugInfo);
+  ASSERT_TRUE(fastRun.optimizeMutatedFunctions);
+
+  for (CodegenProfile profile : { CodegenProfile::Default, CodegenProfile::Auto }) {
+    CodegenPipeline pipeline = codegenPipeline(profile);
+    ASSERT_EQ(pipeline.optimizationLevel, llvm::CodeGenOpt::Default);
+    ASSERT_FALSE(pipeline.fastInstructionSelection);
+    ASSERT_FALSE(pipeline.hostCPU);
+    ASSERT_FALSE(pipeline.stripDebugInfo);
+    ASSERT_FALSE(pipeline.optimizeMutatedFunctions);
+  }
+}
+
+static bool hasAllocas(llvm::Function &function) {
+  for (auto &instruction : function.getEntryBlock()) {
+    if (llvm::isa<llvm::AllocaInst>(instruction)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+TEST(CodegenProfile, CompilesBitcodeWithEachProfile) {
+  llvm::InitializeNativeTarget();
+  llvm::InitializeNativeTargetAsmPrinter();
+
+  for (CodegenProfile profile :
+       { CodegenProfile::Default, CodegenProfile::FastCompile, CodegenProfile::FastRun }) {
+    auto context = std::make_unique<llvm::LLVMContext>();
+    llvm::SMDiagnostic error;
+    std::unique_ptr<llvm::Module> module = llvm::parseAssemblyString(R"(
+define i32 @negate(i1 %condition) {
+entry:
+  %slot = alloca i1
+  store i1 %condition, i1* %slot
+  %value = load i1, i1* %slot
+  %result = zext i1 %value to i32
+  ret i32 %result
+}
+
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!2}
+!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1, producer: "mull", isOptimized: false, runtimeVersion: 0, emissionKind: FullDebug)
+!1 = !DIFile(filename: "negate.c", directory: "/tmp")
+!2 = !{i32 2, !"Debug Info Version", i32 3}
+)",
+                                                                     error,
+                                                                     *context);
+    ASSERT_NE(module, nullptr);
+    module->setTargetTriple(llvm::sys::getProcessTriple());
+    Bitcode bitcode(std::move(context), std::move(module));
+
+    /// The copy of the function stands for the mutated function
+    llvm::Function *negate = bitcode.getModule()->getFunction("negate");
+    NegateConditionMutator mutator;
+    MutationPoint point(&mutator, nullptr, &negate->getEntryBlock().front(), &bitcode);
+    point.setMutatedFunction(negate);
+    bitcode.addMutation(&point);
+
+    Diagnostics diagnostics;
+    Configuration configuration;
+    Compiler compiler(diagnostics, configuration);
+    compiler.setCodegenProfile(profile);
+    std::string objectFile = compiler.compileBitcode(bitcode);
+    ASSERT_FALSE(objectFile.empty());
+    uint64_t size = 0;
+    ASSERT_FALSE(llvm::sys::fs::file_size(objectFile, size));
+    ASSERT_GT(size, 0UL);
+    llvm::sys::fs::remove(objectFile);
+
+    CodegenPipeline pipeline = codegenPipeline(profile);
+    ASSERT_EQ(bitcode.getModule()->getNamedMetadata("llvm.dbg.cu") == nullptr,
+              pipeline.stripDebugInfo);
+    ASSERT_EQ(hasAllocas(*negate), !pipeline.optimizeMutatedFunctions);
+  }
+}
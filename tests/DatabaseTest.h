@@ -0,0 +1,45 @@
+#pragma once
+
+#include "mull/Diagnostics/Diagnostics.h"
+
+#include <gtest/gtest.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+
+#include <memory>
+#include <string>
+
+namespace mull {
+
+/// Runs a store (e.g. the result cache) against a database that does not exist before the test
+/// and is removed after it
+class DatabaseTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    llvm::SmallString<128> path;
+    llvm::sys::fs::createTemporaryFile("mull-test-database", "sqlite", path);
+    llvm::sys::fs::remove(path);
+    databasePath = path.str().str();
+  }
+
+  void TearDown() override {
+    llvm::sys::fs::remove(databasePath);
+  }
+
+  template <typename Store> std::unique_ptr<Store> loadStore() {
+    auto store = std::make_unique<Store>(diagnostics, databasePath);
+    store->load();
+    return store;
+  }
+
+  /// Saves the store and loads it anew, as the next run of Mull would
+  template <typename Store> std::unique_ptr<Store> reload(Store &store) {
+    store.save();
+    return loadStore<Store>();
+  }
+
+  Diagnostics diagnostics;
+  std::string databasePath;
+};
+
+} // namespace mull
@@ -1,5 +1,6 @@
 #include "FixturePaths.h"
 #include "TestModuleFactory.h"
+#include "mull/BitcodeLoader.h"
 #include "mull/Config/Configuration.h"
 #include "mull/Driver.h"
 #include "mull/MutationsFinder.h"
@@ -12,6 +13,7 @@
 #include <utility>
 
 #include <gtest/gtest.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/YAMLParser.h>
 #include <mull/Diagnostics/Diagnostics.h>
@@ -35,3 +37,49 @@ TEST(Driver, RunningWithNoTests) {
   auto result = driver.run();
   ASSERT_EQ(0u, result->getMutationResults().size());
 }
+
+TEST(Driver, StreamingFindsTheSameMutants) {
+  Configuration configuration;
+  configuration.skipSanityCheckRun = true;
+  configuration.dryRunEnabled = true;
+  Diagnostics diagnostics;
+  Toolchain toolchain(diagnostics, configuration);
+  Filters filters;
+
+  std::vector<std::string> paths({ fixtures::simple_test_count_letters_test_count_letters_bc_path(),
+                                   fixtures::simple_test_count_letters_count_letters_bc_path() });
+
+  BitcodeLoader loader;
+  std::vector<std::unique_ptr<Bitcode>> bitcode;
+  std::vector<std::unique_ptr<MemoryBuffer>> ownedBuffers;
+  std::vector<MemoryBufferRef> buffers;
+  for (auto &path : paths) {
+    bitcode.push_back(loader.loadBitcodeAtPath(path, diagnostics));
+    ownedBuffers.push_back(std::move(MemoryBuffer::getFile(path).get()));
+    buffers.push_back(ownedBuffers.back()->getMemBufferRef());
+  }
+
+  std::vector<std::unique_ptr<Mutator>> mutators;
+  mutators.emplace_back(std::make_unique<cxx::AddToSub>());
+  MutationsFinder finder(std::move(mutators), configuration);
+  Program program(std::move(bitcode));
+  Driver driver(diagnostics, configuration, program, toolchain, filters, finder);
+  auto result = driver.run();
+
+  /// The budget is too small for any module, each one is processed in its own batch
+  std::vector<std::unique_ptr<Mutator>> streamingMutators;
+  streamingMutators.emplace_back(std::make_unique<cxx::AddToSub>());
+  MutationsFinder streamingFinder(std::move(streamingMutators), configuration);
+  Program streamingProgram = Program::fromBitcodeBuffers(buffers);
+  Driver streamingDriver(
+      diagnostics, configuration, streamingProgram, toolchain, filters, streamingFinder);
+  auto streamingResult = streamingDriver.run();
+
+  ASSERT_FALSE(result->getMutants().empty());
+  ASSERT_EQ(result->getMutants().size(), streamingResult->getMutants().size());
+  for (size_t i = 0; i < result->getMutants().size(); i++) {
+    ASSERT_EQ(result->getMutants()[i]->getIdentifier(),
+              streamingResult->getMutants()[i]->getIdentifier());
+  }
+  ASSERT_TRUE(streamingProgram.bitcode().empty());
+}
@@ -0,0 +1,67 @@
+#include "mull/Parallelization/Tasks/EquivalentMutantsTask.h"
+
+#include "mull/Bitcode.h"
+#include "mull/FunctionUnderTest.h"
+#include "mull/MutationPoint.h"
+#include "mull/Mutators/CXX/ArithmeticMutators.h"
+#include "mull/Parallelization/Tasks/MutantPreparationTasks.h"
+
+#include <gtest/gtest.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/SourceMgr.h>
+
+using namespace mull;
+
+static const char *Program = R"(
+define i32 @compute(i32 %a) {
+  %unused = add i32 %a, 1
+  %used = add i32 %a, 2
+  ret i32 %used
+}
+)";
+
+TEST(EquivalentMutants, DetectsMutantsOfDeadCode) {
+  auto context = std::make_unique<llvm::LLVMContext>();
+  llvm::SMDiagnostic error;
+  auto module = llvm::parseAssemblyString(Program, error, *context);
+  Bitcode bitcode(std::move(context), std::move(module));
+
+  cxx::AddToSub mutator;
+  FunctionUnderTest function(bitcode.getModule()->getFunction("compute"), &bitcode);
+  function.selectInstructions({});
+  std::vector<MutationPoint *> points = mutator.getMutations(&bitcode, function);
+  ASSERT_EQ(points.size(), 2U);
+  for (auto point : points) {
+    bitcode.addMutation(point);
+  }
+
+  CloneMutatedFunctionsTask::cloneFunctions(bitcode);
+  DeleteOriginalFunctionsTask::deleteFunctions(bitcode);
+  InsertMutationTrampolinesTask::insertTrampolines(bitcode);
+  for (auto point : points) {
+    point->applyMutation();
+  }
+
+  std::vector<MutationPointFingerprint> fingerprints;
+  EquivalentMutantsTask::fingerprintMutants(bitcode, fingerprints);
+  ASSERT_EQ(fingerprints.size(), 2U);
+  std::map<MutationPoint *, MutationPointFingerprint> byPoint;
+  for (auto &fingerprint : fingerprints) {
+    byPoint.emplace(fingerprint.point, fingerprint);
+  }
+
+  /// The unused value is optimized away together with its mutation
+  ASSERT_TRUE(byPoint.at(points[0]).equivalent);
+  ASSERT_FALSE(byPoint.at(points[1]).equivalent);
+  ASSERT_NE(byPoint.at(points[0]).fingerprint, byPoint.at(points[1]).fingerprint);
+
+  /// The temporary copies are gone
+  ASSERT_EQ(bitcode.getModule()->getFunction("mull_equivalence_copy"), nullptr);
+  ASSERT_FALSE(llvm::verifyModule(*bitcode.getModule(), &llvm::errs()));
+
+  for (auto point : points) {
+    delete point;
+  }
+}
@@ -0,0 +1,55 @@
+#include "FixturePaths.h"
+#include "mull/JunkDetection/CXX/ASTStorage.h"
+#include <mull/Diagnostics/Diagnostics.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+using namespace mull;
+
+TEST(ASTStorage, ParsesEachUnitOnceForAllThreads) {
+  Diagnostics diagnostics;
+  ASTStorage astStorage(diagnostics, "", "", {});
+  std::vector<std::string> files({ fixtures::junk_detection_shared_preamble_first_cpp_path(),
+                                   fixtures::junk_detection_shared_preamble_second_cpp_path() });
+
+  const size_t threadsCount = 8;
+  const size_t lookupsCount = 4;
+  std::vector<std::vector<ThreadSafeASTUnit *>> found(threadsCount);
+  std::atomic<size_t> ready(0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < threadsCount; i++) {
+    threads.emplace_back([&, i]() {
+      /// All of the threads ask at once, half of them start with the first file and the other
+      /// half with the second one
+      ready++;
+      while (ready < threadsCount) {
+        std::this_thread::yield();
+      }
+      for (size_t lookup = 0; lookup < lookupsCount; lookup++) {
+        found[i].push_back(astStorage.findAST(files[(i + lookup) % files.size()]));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::vector<ThreadSafeASTUnit *> units;
+  for (auto &file : files) {
+    units.push_back(astStorage.findAST(file));
+    ASSERT_NE(units.back(), nullptr);
+    auto unitFiles = units.back()->getFiles();
+    ASSERT_NE(std::find(unitFiles.begin(), unitFiles.end(), file), unitFiles.end());
+  }
+  ASSERT_NE(units[0], units[1]);
+
+  for (size_t i = 0; i < threadsCount; i++) {
+    for (size_t lookup = 0; lookup < lookupsCount; lookup++) {
+      ASSERT_EQ(found[i][lookup], units[(i + lookup) % files.size()]);
+    }
+  }
+}
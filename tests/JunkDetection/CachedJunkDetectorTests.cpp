@@ -0,0 +1,155 @@
+#include "FixturePaths.h"
+#include "mull/Bitcode.h"
+#include "mull/BitcodeLoader.h"
+#include "mull/FunctionUnderTest.h"
+#include "mull/JunkDetection/CXX/CXXJunkDetector.h"
+#include "mull/JunkDetection/CXX/CachedJunkDetector.h"
+#include "mull/MutationPoint.h"
+#include <mull/Diagnostics/Diagnostics.h>
+#include <mull/Mutators/CXX/ArithmeticMutators.h>
+
+#include <gtest/gtest.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/SourceMgr.h>
+#include <llvm/Support/raw_ostream.h>
+
+using namespace mull;
+
+class CountingJunkDetector : public JunkDetector {
+public:
+  explicit CountingJunkDetector(JunkDetector &junkDetector) : junkDetector(junkDetector) {}
+  bool isJunk(MutationPoint *point) override {
+    calls++;
+    return junkDetector.isJunk(point);
+  }
+  JunkDetector &junkDetector;
+  int calls = 0;
+};
+
+/// Runs the cached junk detector over the bitcode and returns how many times the AST-based
+/// detector was asked
+static int detectJunk(const std::string &databasePath, Bitcode &bitcode,
+                      std::vector<std::string> &nonJunk) {
+  Diagnostics diagnostics;
+  cxx::AddToSub mutator;
+  std::vector<MutationPoint *> points;
+  for (auto &function : bitcode.getModule()->functions()) {
+    FunctionUnderTest functionUnderTest(&function, &bitcode);
+    functionUnderTest.selectInstructions({});
+    auto mutants = mutator.getMutations(&bitcode, functionUnderTest);
+    std::copy(mutants.begin(), mutants.end(), std::back_inserter(points));
+  }
+
+  ASTStorage astStorage(diagnostics, "", "", {});
+  CXXJunkDetector detector(diagnostics, astStorage);
+  CountingJunkDetector countingDetector(detector);
+  CachedJunkDetector cachedDetector(diagnostics, astStorage, countingDetector, databasePath);
+  cachedDetector.load();
+
+  nonJunk.clear();
+  for (auto point : points) {
+    if (!cachedDetector.isJunk(point)) {
+      nonJunk.push_back(point->getUserIdentifier() + ":" +
+                        std::to_string(point->getEndLocation().line) + ":" +
+                        std::to_string(point->getEndLocation().column));
+    }
+    delete point;
+  }
+  cachedDetector.save();
+  return countingDetector.calls;
+}
+
+static int detectJunk(const std::string &databasePath, std::vector<std::string> &nonJunk) {
+  Diagnostics diagnostics;
+  BitcodeLoader loader;
+  auto bitcode =
+      loader.loadBitcodeAtPath(fixtures::mutators_math_add_module_bc_path(), diagnostics);
+  return detectJunk(databasePath, *bitcode, nonJunk);
+}
+
+TEST(CachedJunkDetector, ReusesVerdictsOfUnchangedUnits) {
+  llvm::SmallString<128> path;
+  llvm::sys::fs::createTemporaryFile("mull-junk-cache", "sqlite", path);
+  llvm::sys::fs::remove(path);
+  std::string databasePath = path.str().str();
+
+  std::vector<std::string> detected;
+  ASSERT_NE(detectJunk(databasePath, detected), 0);
+  ASSERT_EQ(detected.size(), 6U);
+
+  std::vector<std::string> cached;
+  ASSERT_EQ(detectJunk(databasePath, cached), 0);
+  ASSERT_EQ(cached, detected);
+
+  llvm::sys::fs::remove(path);
+}
+
+/// The 'sum' function of the shared preamble fixture, compiled from the directory DIRECTORY
+static const char *SumProgram = R"(
+define i32 @sum(i32 %a, i32 %b) !dbg !5 {
+  %sum = add nsw i32 %a, %b, !dbg !8
+  ret i32 %sum, !dbg !9
+}
+
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!3, !4}
+
+!0 = distinct !DICompileUnit(language: DW_LANG_C_plus_plus, file: !1, isOptimized: false, runtimeVersion: 0, emissionKind: FullDebug)
+!1 = !DIFile(filename: "first.cpp", directory: "DIRECTORY")
+!3 = !{i32 2, !"Dwarf Version", i32 4}
+!4 = !{i32 2, !"Debug Info Version", i32 3}
+!5 = distinct !DISubprogram(name: "sum", scope: !1, file: !1, line: 3, type: !6, isLocal: false, isDefinition: true, scopeLine: 3, unit: !0)
+!6 = !DISubroutineType(types: !7)
+!7 = !{}
+!8 = !DILocation(line: 4, column: 12, scope: !5)
+!9 = !DILocation(line: 4, column: 3, scope: !5)
+)";
+
+TEST(CachedJunkDetector, RejectsVerdictsOfUnitsWithChangedHeaders) {
+  llvm::SmallString<128> prefix;
+  llvm::sys::path::system_temp_directory(true, prefix);
+  llvm::sys::path::append(prefix, "mull-junk-cache");
+  llvm::SmallString<128> directory;
+  ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory(prefix, directory));
+  std::string unitDirectory = directory.str().str();
+  std::string header = unitDirectory + "/shared.h";
+  ASSERT_FALSE(llvm::sys::fs::copy_file(fixtures::junk_detection_shared_preamble_first_cpp_path(),
+                                        unitDirectory + "/first.cpp"));
+  ASSERT_FALSE(llvm::sys::fs::copy_file(fixtures::junk_detection_shared_preamble_shared_h_path(),
+                                        header));
+  std::string databasePath = unitDirectory + "/junk.sqlite";
+
+  std::string program(SumProgram);
+  std::string placeholder("DIRECTORY");
+  program.replace(program.find(placeholder), placeholder.size(), unitDirectory);
+  auto context = std::make_unique<llvm::LLVMContext>();
+  llvm::SMDiagnostic error;
+  auto module = llvm::parseAssemblyString(program, error, *context);
+  ASSERT_NE(module, nullptr);
+  Bitcode bitcode(std::move(context), std::move(module));
+
+  std::vector<std::string> detected;
+  ASSERT_NE(detectJunk(databasePath, bitcode, detected), 0);
+  ASSERT_EQ(detected.size(), 1U);
+
+  std::vector<std::string> cached;
+  ASSERT_EQ(detectJunk(databasePath, bitcode, cached), 0);
+  ASSERT_EQ(cached, detected);
+
+  {
+    std::error_code errorCode;
+    llvm::raw_fd_ostream stream(header, errorCode, llvm::sys::fs::OpenFlags::F_Append);
+    ASSERT_FALSE(errorCode);
+    stream << "\nstatic inline int thrice(int x) {\n  return x + x + x;\n}\n";
+  }
+
+  std::vector<std::string> redetected;
+  ASSERT_NE(detectJunk(databasePath, bitcode, redetected), 0);
+  ASSERT_EQ(redetected, detected);
+
+  llvm::sys::fs::remove_directories(unitDirectory);
+}
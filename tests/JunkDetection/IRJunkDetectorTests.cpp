@@ -0,0 +1,61 @@
+#include "mull/JunkDetection/IRJunkDetector.h"
+
+#include "mull/Bitcode.h"
+#include "mull/FunctionUnderTest.h"
+#include "mull/MutationPoint.h"
+#include "mull/Mutators/CXX/ArithmeticMutators.h"
+
+#include <gtest/gtest.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/Support/SourceMgr.h>
+
+using namespace mull;
+
+static const char *Program = R"(
+define i32 @compute(i32 %a) !dbg !6 {
+entry:
+  %used = add i32 %a, 1, !dbg !9
+  %unused = add i32 %a, 2, !dbg !9
+  %temporary = add i32 %used, 3
+  ret i32 %temporary, !dbg !9
+unreachable:
+  %dead = add i32 %a, 4, !dbg !9
+  ret i32 %dead, !dbg !9
+}
+
+!llvm.dbg.cu = !{!0}
+!llvm.module.flags = !{!3, !4}
+!0 = distinct !DICompileUnit(language: DW_LANG_C99, file: !1, isOptimized: false, runtimeVersion: 0, emissionKind: FullDebug)
+!1 = !DIFile(filename: "compute.c", directory: "/tmp")
+!3 = !{i32 2, !"Dwarf Version", i32 4}
+!4 = !{i32 2, !"Debug Info Version", i32 3}
+!6 = distinct !DISubprogram(name: "compute", scope: !1, file: !1, line: 1, type: !7, isLocal: false, isDefinition: true, scopeLine: 1, unit: !0)
+!7 = !DISubroutineType(types: !8)
+!8 = !{null}
+!9 = !DILocation(line: 2, column: 3, scope: !6)
+)";
+
+TEST(IRJunkDetector, DetectsUnusedUnreachableAndGeneratedCode) {
+  auto context = std::make_unique<llvm::LLVMContext>();
+  llvm::SMDiagnostic error;
+  auto module = llvm::parseAssemblyString(Program, error, *context);
+  ASSERT_NE(module, nullptr);
+  Bitcode bitcode(std::move(context), std::move(module));
+
+  cxx::AddToSub mutator;
+  FunctionUnderTest function(bitcode.getModule()->getFunction("compute"), &bitcode);
+  function.selectInstructions({});
+  std::vector<MutationPoint *> points = mutator.getMutations(&bitcode, function);
+  ASSERT_EQ(points.size(), 4U);
+
+  IRJunkDetector detector;
+  std::vector<std::string> nonJunk;
+  for (auto point : points) {
+    if (!detector.isJunk(point)) {
+      nonJunk.push_back(point->getOriginalValue()->getName().str());
+    }
+    delete point;
+  }
+  ASSERT_EQ(nonJunk, std::vector<std::string>({ "used" }));
+}
@@ -0,0 +1,106 @@
+#include "FixturePaths.h"
+#include "mull/BitcodeLoader.h"
+#include "mull/FunctionUnderTest.h"
+#include "mull/JunkDetection/CXX/CXXJunkDetector.h"
+#include "mull/JunkDetection/CXX/SharedPreambles.h"
+#include "mull/MutationPoint.h"
+#include <mull/Diagnostics/Diagnostics.h>
+#include <mull/Mutators/CXX/ArithmeticMutators.h>
+
+#include <gtest/gtest.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/Path.h>
+
+#include <algorithm>
+
+using namespace mull;
+
+/// Returns the verdict and the end location of each mutant of the fixture
+static std::vector<std::string> detectJunk(ASTStorage &astStorage, const char *bitcodePath) {
+  Diagnostics diagnostics;
+  BitcodeLoader loader;
+  auto bitcode = loader.loadBitcodeAtPath(bitcodePath, diagnostics);
+
+  cxx::AddToSub mutator;
+  std::vector<MutationPoint *> points;
+  for (auto &function : bitcode->getModule()->functions()) {
+    FunctionUnderTest functionUnderTest(&function, bitcode.get());
+    functionUnderTest.selectInstructions({});
+    auto mutants = mutator.getMutations(bitcode.get(), functionUnderTest);
+    std::copy(mutants.begin(), mutants.end(), std::back_inserter(points));
+  }
+
+  CXXJunkDetector detector(diagnostics, astStorage);
+  std::vector<std::string> verdicts;
+  for (auto point : points) {
+    bool junk = detector.isJunk(point);
+    verdicts.push_back(point->getUserIdentifier() + (junk ? ":junk:" : ":") +
+                       std::to_string(point->getEndLocation().line) + ":" +
+                       std::to_string(point->getEndLocation().column));
+    delete point;
+  }
+  return verdicts;
+}
+
+TEST(SharedPreambles, PrecompilesThePreambleOnceItIsShared) {
+  Diagnostics diagnostics;
+  SharedPreambles sharedPreambles(diagnostics);
+
+  std::string blankedContents;
+  ASSERT_TRUE(sharedPreambles
+                  .flagsFor(fixtures::junk_detection_shared_preamble_first_cpp_path(),
+                            {},
+                            blankedContents)
+                  .empty());
+  ASSERT_TRUE(blankedContents.empty());
+
+  const char *second = fixtures::junk_detection_shared_preamble_second_cpp_path();
+  std::vector<std::string> flags = sharedPreambles.flagsFor(second, {}, blankedContents);
+  ASSERT_EQ(flags.size(), 2U);
+  ASSERT_EQ(flags[0], "-include-pch");
+  ASSERT_TRUE(llvm::sys::fs::exists(flags[1]));
+  ASSERT_TRUE(sharedPreambles.isTemporary(flags[1]));
+
+  /// The unit is parsed from memory, its preamble is blanked and the lines stay where they were
+  auto contents = llvm::MemoryBuffer::getFile(second);
+  ASSERT_TRUE(bool(contents));
+  std::string original = contents.get()->getBuffer().str();
+  ASSERT_EQ(blankedContents.size(), original.size());
+  ASSERT_EQ(std::count(blankedContents.begin(), blankedContents.end(), '\n'),
+            std::count(original.begin(), original.end(), '\n'));
+  ASSERT_EQ(blankedContents.find("#include"), std::string::npos);
+  ASSERT_NE(original.find("#include"), std::string::npos);
+}
+
+TEST(SharedPreambles, DetectsTheSameJunkAsSeparateUnits) {
+  Diagnostics diagnostics;
+  const char *first = fixtures::junk_detection_shared_preamble_first_bc_path();
+  const char *second = fixtures::junk_detection_shared_preamble_second_bc_path();
+
+  /// A unit parsed on its own never shares its preamble
+  ASTStorage firstStorage(diagnostics, "", "", {});
+  ASTStorage secondStorage(diagnostics, "", "", {});
+  std::vector<std::string> expected = detectJunk(firstStorage, first);
+  std::vector<std::string> secondExpected = detectJunk(secondStorage, second);
+  expected.insert(expected.end(), secondExpected.begin(), secondExpected.end());
+
+  ASTStorage sharedStorage(diagnostics, "", "", {});
+  std::vector<std::string> detected = detectJunk(sharedStorage, first);
+  std::vector<std::string> secondDetected = detectJunk(sharedStorage, second);
+  detected.insert(detected.end(), secondDetected.begin(), secondDetected.end());
+
+  auto files =
+      sharedStorage.findAST(fixtures::junk_detection_shared_preamble_second_cpp_path())->getFiles();
+  ASSERT_TRUE(std::any_of(files.begin(), files.end(), [](const std::string &file) {
+    return llvm::sys::path::extension(file) == ".pch";
+  }));
+  /// The blanked unit keeps the name of the file it replaces
+  ASSERT_NE(std::find(files.begin(),
+                      files.end(),
+                      fixtures::junk_detection_shared_preamble_second_cpp_path()),
+            files.end());
+
+  ASSERT_EQ(expected.size(), 4U);
+  ASSERT_EQ(detected, expected);
+}
@@ -0,0 +1,42 @@
+#include "mull/KillMatrix.h"
+
+#include "DatabaseTest.h"
+
+#include <gtest/gtest.h>
+
+using namespace mull;
+
+using KillMatrixTest = DatabaseTest;
+
+TEST_F(KillMatrixTest, SubsumesMutantsKilledByMoreTests) {
+  auto recorded = loadStore<KillMatrix>();
+  ASSERT_TRUE(recorded->empty());
+  /// weak is killed by every test that kills a or b, c is killed by the same tests as a
+  recorded->recordRun("a", "t1", true);
+  recorded->recordRun("a", "t2", false);
+  recorded->recordRun("b", "t2", true);
+  recorded->recordRun("c", "t1", true);
+  recorded->recordRun("weak", "t1", true);
+  recorded->recordRun("weak", "t2", true);
+  recorded->recordRun("survivor", "t1", false);
+
+  auto matrix = reload(*recorded);
+  ASSERT_FALSE(matrix->empty());
+  auto subsumed = matrix->subsumedMutants({ "a", "b", "c", "weak", "survivor", "new" });
+  ASSERT_EQ(subsumed.size(), 2U);
+  ASSERT_EQ(subsumed.at("c"), std::vector<std::string>({ "a" }));
+  ASSERT_EQ(subsumed.at("weak"), std::vector<std::string>({ "a", "b" }));
+
+  /// Only the given mutants are compared
+  subsumed = matrix->subsumedMutants({ "weak", "c" });
+  ASSERT_EQ(subsumed.size(), 1U);
+  ASSERT_EQ(subsumed.at("weak"), std::vector<std::string>({ "c" }));
+
+  /// A re-run replaces the whole row of the mutant
+  matrix->recordRun("weak", "t1", false);
+  matrix->recordRun("weak", "t2", true);
+  auto updated = reload(*matrix);
+  subsumed = updated->subsumedMutants({ "a", "b", "weak" });
+  ASSERT_EQ(subsumed.size(), 1U);
+  ASSERT_EQ(subsumed.at("weak"), std::vector<std::string>({ "b" }));
+}
@@ -4,6 +4,10 @@
 #include "FixturePaths.h"
 #include "mull/BitcodeLoader.h"
 #include "mull/Config/Configuration.h"
+#include "mull/Parallelization/Parallelization.h"
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/Support/MemoryBuffer.h>
 
 using namespace mull;
 using namespace llvm;
@@ -17,3 +21,26 @@ TEST(BitcodeLoaderTest, loadBitcodeFromBitcodeListFile) {
 
   ASSERT_EQ(bitcode.size(), 1U);
 }
+
+TEST(BitcodeLoaderTest, loadLazyModuleMaterializesOnlySelectedFunctions) {
+  Diagnostics diagnostics;
+  auto buffer = MemoryBuffer::getFile(fixtures::simple_test_count_letters_count_letters_bc_path());
+  ASSERT_TRUE(bool(buffer));
+
+  auto context = std::make_unique<LLVMContext>();
+  auto module = loadLazyModuleFromBuffer(*context, std::move(buffer.get()), diagnostics);
+  ASSERT_NE(module, nullptr);
+  Function *function = module->getFunction("count_letters");
+  ASSERT_TRUE(function->isMaterializable());
+
+  std::vector<std::unique_ptr<Bitcode>> bitcode;
+  bitcode.push_back(std::make_unique<Bitcode>(std::move(context), std::move(module)));
+  std::unordered_set<Function *> functions({ function });
+  MaterializeFunctionsTask task(diagnostics, &functions);
+  std::vector<int> nothing;
+  progress_counter counter;
+  task(bitcode.begin(), bitcode.end(), nothing, counter);
+
+  ASSERT_FALSE(function->isMaterializable());
+  ASSERT_FALSE(function->empty());
+}
@@ -1,14 +1,19 @@
 #include "FixturePaths.h"
 #include "mull/BitcodeLoader.h"
 #include "mull/Config/Configuration.h"
+#include "mull/Filters/EquivalentMutationFilter.h"
 #include "mull/Filters/FilePathFilter.h"
 #include "mull/Filters/NoDebugInfoFilter.h"
 #include "mull/MutationsFinder.h"
 #include "mull/Program/Program.h"
 #include <mull/Mutators/CXX/ArithmeticMutators.h>
+#include <mull/Mutators/CXX/BitwiseMutators.h>
+#include <mull/Mutators/CXX/RelationalMutators.h>
 
 #include <gtest/gtest.h>
+#include <llvm/AsmParser/Parser.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/Support/SourceMgr.h>
 #include <mull/Diagnostics/Diagnostics.h>
 
 using namespace mull;
@@ -183,3 +188,64 @@ TEST(FilePathFilter, filtersWithRegex) {
 
   ASSERT_EQ(filteredPoints.size(), size_t(0));
 }
+
+static const char *EquivalentMutationsProgram = R"(
+define i32 @compute(i32 %a, i32 %b) {
+  %add_zero = add i32 %a, 0
+  %add_one = add i32 %add_zero, 1
+  %shl_zero = shl i32 %add_one, 0
+  %shl_one = shl i32 %shl_zero, 1
+  %and_same = and i32 %shl_one, %shl_one
+  %and_other = and i32 %and_same, %b
+  %slt_same = icmp slt i32 %a, %a
+  %sgt_folded = icmp sgt i32 2, 1
+  %slt_other = icmp slt i32 %a, %b
+  %r1 = select i1 %slt_same, i32 %and_other, i32 0
+  %r2 = select i1 %sgt_folded, i32 %r1, i32 0
+  %r3 = select i1 %slt_other, i32 %r2, i32 0
+  ret i32 %r3
+}
+)";
+
+TEST(EquivalentMutationFilter, prunesMutantsEquivalentByConstruction) {
+  auto context = std::make_unique<llvm::LLVMContext>();
+  llvm::SMDiagnostic error;
+  auto module = llvm::parseAssemblyString(EquivalentMutationsProgram, error, *context);
+  Bitcode bitcode(std::move(context), std::move(module));
+  FunctionUnderTest function(bitcode.getModule()->getFunction("compute"), &bitcode);
+  function.selectInstructions({});
+
+  cxx::AddToSub addToSub;
+  cxx::LShiftToRShift shiftToRight;
+  cxx::BitwiseAndToOr andToOr;
+  cxx::LessThanToLessOrEqual lessThanToLessOrEqual;
+  cxx::GreaterThanToGreaterOrEqual greaterThanToGreaterOrEqual;
+  std::vector<Mutator *> mutators({ &addToSub,
+                                    &shiftToRight,
+                                    &andToOr,
+                                    &lessThanToLessOrEqual,
+                                    &greaterThanToGreaterOrEqual });
+
+  std::vector<MutationPoint *> points;
+  for (auto mutator : mutators) {
+    auto mutants = mutator->getMutations(&bitcode, function);
+    std::copy(mutants.begin(), mutants.end(), std::back_inserter(points));
+  }
+  ASSERT_EQ(points.size(), 9U);
+
+  EquivalentMutationFilter filter;
+  std::vector<std::string> kept;
+  for (auto point : points) {
+    if (!filter.shouldSkip(point)) {
+      kept.push_back(point->getOriginalValue()->getName().str());
+    }
+  }
+  /// x < x is false, x <= x is true, so that mutant stays
+  ASSERT_EQ(
+      kept,
+      std::vector<std::string>({ "add_one", "shl_one", "and_other", "slt_same", "slt_other" }));
+
+  for (auto point : points) {
+    delete point;
+  }
+}
@@ -11,6 +11,7 @@
 #include <llvm/IR/InstrTypes.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Verifier.h>
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 #include <mull/Diagnostics/Diagnostics.h>
@@ -131,6 +132,40 @@ TEST(MutationPoint, OriginalValuePresent) {
   }
 }
 
+TEST(MutationPoint, MutantSchemata) {
+  Diagnostics diagnostics;
+  BitcodeLoader loader;
+  auto bitcode =
+      loader.loadBitcodeAtPath(fixtures::mutators_replace_assignment_module_bc_path(), diagnostics);
+
+  cxx::NumberAssignConst mutator;
+  FunctionUnderTest functionUnderTest(bitcode->getModule()->getFunction("replace_assignment"),
+                                      bitcode.get());
+  functionUnderTest.selectInstructions({});
+  auto mutationPoints = mutator.getMutations(bitcode.get(), functionUnderTest);
+
+  ASSERT_EQ(2U, mutationPoints.size());
+
+  for (auto *mutation : mutationPoints) {
+    bitcode->addMutation(mutation);
+  }
+
+  CloneMutatedFunctionsTask::cloneFunctions(*bitcode, true);
+  DeleteOriginalFunctionsTask::deleteFunctions(*bitcode);
+  InsertMutationTrampolinesTask::insertTrampolines(*bitcode);
+
+  for (auto *mutation : mutationPoints) {
+    mutation->applyMutation();
+  }
+
+  ASSERT_EQ(mutationPoints[0]->getMutatedFunction(), mutationPoints[1]->getMutatedFunction());
+  ASSERT_EQ(1, mutationPoints[0]->getSchemataIndex());
+  ASSERT_EQ(2, mutationPoints[1]->getSchemataIndex());
+  ASSERT_NE(nullptr,
+            bitcode->getModule()->getNamedGlobal(mutationPoints[0]->getSchemataSelectorName()));
+  ASSERT_FALSE(llvm::verifyModule(*bitcode->getModule(), &llvm::errs()));
+}
+
 TEST(MutationPoint, dump) {
   Diagnostics diagnostics;
   BitcodeLoader loader;
@@ -0,0 +1,65 @@
+#include "mull/Runtime/ReachabilityRuntime.h"
+
+#include <gtest/gtest.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/SourceMgr.h>
+
+using namespace mull;
+
+TEST(ReachabilityRuntime, MutantIsReachedByAnyOfItsSlots) {
+  ReachabilitySlots slots;
+  slots.add("first");
+  slots.add("second");
+  slots.add("first");
+  slots.add("third");
+  ASSERT_EQ(slots.size(), 4UL);
+
+  std::string bitmap({ 0, 0, 1, 0 });
+  ASSERT_EQ(slots.unreachedMutants(bitmap),
+            std::unordered_set<std::string>({ "second", "third" }));
+  /// A truncated bitmap reaches nothing past its end
+  ASSERT_EQ(slots.unreachedMutants(std::string({ 0, 1 })),
+            std::unordered_set<std::string>({ "first", "third" }));
+}
+
+TEST(ReachabilityRuntime, InsertsProbesBeforeInstructions) {
+  llvm::LLVMContext context;
+  llvm::SMDiagnostic error;
+  std::unique_ptr<llvm::Module> module = llvm::parseAssemblyString(R"(
+define i32 @sum(i1 %condition, i32 %a, i32 %b) {
+entry:
+  br i1 %condition, label %add, label %done
+add:
+  %c = add i32 %a, %b
+  br label %done
+done:
+  %result = phi i32 [ %c, %add ], [ %a, %entry ]
+  ret i32 %result
+}
+)",
+                                                                   error,
+                                                                   context);
+  ASSERT_NE(module, nullptr);
+  llvm::Function *sum = module->getFunction("sum");
+  std::vector<llvm::BasicBlock *> blocks;
+  for (auto &block : *sum) {
+    blocks.push_back(&block);
+  }
+  llvm::Instruction *add = &blocks[1]->front();
+  llvm::Instruction *phi = &blocks[2]->front();
+
+  insertReachabilityProbes(*module, { { add, 3 }, { phi, 5 } });
+  ASSERT_FALSE(llvm::verifyModule(*module, &llvm::errs()));
+
+  /// A probe is a load of the bitmap, a GEP, and a store; the PHI gets it after the PHIs
+  ASSERT_TRUE(llvm::isa<llvm::StoreInst>(add->getPrevNode()));
+  ASSERT_TRUE(llvm::isa<llvm::LoadInst>(phi->getNextNode()));
+  ASSERT_TRUE(llvm::isa<llvm::StoreInst>(phi->getNextNode()->getNextNode()->getNextNode()));
+
+  ASSERT_NE(module->getFunction("mull_map_reachability"), nullptr);
+  ASSERT_NE(module->getNamedGlobal("llvm.global_ctors"), nullptr);
+}
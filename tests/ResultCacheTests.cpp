@@ -0,0 +1,109 @@
+#include "mull/ResultCache.h"
+
+#include "DatabaseTest.h"
+#include "mull/Bitcode.h"
+#include "mull/FunctionUnderTest.h"
+#include "mull/Mutant.h"
+#include "mull/MutationPoint.h"
+#include "mull/Mutators/CXX/ArithmeticMutators.h"
+
+#include <gtest/gtest.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/Support/SourceMgr.h>
+
+using namespace mull;
+
+static const char *Program = R"(
+define i32 @callee(i32 %a) {
+  %r = add i32 %a, CALLEE
+  ret i32 %r
+}
+
+define i32 @sum(i32 %a, i32 %b) {
+  %c = add i32 %a, %b
+  %d = call i32 @callee(i32 %c)
+  ret i32 %d
+}
+
+define i32 @other() {
+  ret i32 OTHER
+}
+
+define i32 @caller(i32 %a) {
+  %s = call i32 @sum(i32 %a, i32 %a)
+  %r = add i32 %s, CALLER
+  ret i32 %r
+}
+)";
+
+class ResultCacheTest : public DatabaseTest {
+protected:
+  /// Runs the cache against the program and returns true if the result of the mutant is reused
+  bool isCached(int callee, int other, int caller = 3);
+};
+
+bool ResultCacheTest::isCached(int callee, int other, int caller) {
+  std::string source(Program);
+  source.replace(source.find("CALLEE"), 6, std::to_string(callee));
+  source.replace(source.find("OTHER"), 5, std::to_string(other));
+  source.replace(source.find("CALLER"), 6, std::to_string(caller));
+
+  auto context = std::make_unique<llvm::LLVMContext>();
+  llvm::SMDiagnostic error;
+  auto module = llvm::parseAssemblyString(source, error, *context);
+  std::vector<std::unique_ptr<Bitcode>> program;
+  program.push_back(std::make_unique<Bitcode>(std::move(context), std::move(module)));
+
+  cxx::AddToSub mutator;
+  FunctionUnderTest function(program.front()->getModule()->getFunction("sum"),
+                             program.front().get());
+  function.selectInstructions({});
+  std::vector<MutationPoint *> points = mutator.getMutations(program.front().get(), function);
+  EXPECT_EQ(points.size(), 1U);
+  /// The caller of the mutated function is mutated as well
+  FunctionUnderTest callerFunction(program.front()->getModule()->getFunction("caller"),
+                                   program.front().get());
+  callerFunction.selectInstructions({});
+  std::vector<MutationPoint *> callerPoints =
+      mutator.getMutations(program.front().get(), callerFunction);
+  EXPECT_EQ(callerPoints.size(), 1U);
+  std::vector<MutationPoint *> allPoints(points);
+  allPoints.insert(allPoints.end(), callerPoints.begin(), callerPoints.end());
+  Mutant mutant(points.front()->getUserIdentifier(),
+                points.front()->getMutatorIdentifier(),
+                points.front()->getSourceLocation(),
+                points.front()->getEndLocation(),
+                true);
+
+  auto cache = loadStore<ResultCache>();
+  cache->hashProgram(program, allPoints);
+  ExecutionResult result;
+  bool cached = cache->lookup(mutant, result);
+  if (cached) {
+    EXPECT_EQ(result.status, Failed);
+    EXPECT_EQ(result.source, StatusSource::Cached);
+  } else {
+    result.status = Failed;
+    cache->store(mutant, result);
+    cache->save();
+  }
+  for (auto point : allPoints) {
+    delete point;
+  }
+  return cached;
+}
+
+TEST_F(ResultCacheTest, ReusesResultsOfUnchangedCode) {
+  ASSERT_FALSE(isCached(1, 7));
+  ASSERT_TRUE(isCached(1, 7));
+  /// The callee of the mutated function changed
+  ASSERT_FALSE(isCached(2, 7));
+  ASSERT_TRUE(isCached(2, 7));
+  /// The rest of the program changed
+  ASSERT_FALSE(isCached(2, 8));
+  ASSERT_TRUE(isCached(2, 8));
+  /// A mutated caller of the mutated function changed
+  ASSERT_FALSE(isCached(2, 8, 4));
+  ASSERT_TRUE(isCached(2, 8, 4));
+}
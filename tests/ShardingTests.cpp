@@ -0,0 +1,117 @@
+#include "mull/Sharding.h"
+
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Mutant.h"
+#include "mull/MutationResult.h"
+#include "mull/Result.h"
+
+#include <gtest/gtest.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+
+using namespace mull;
+
+static std::vector<std::unique_ptr<Mutant>> makeMutants(int count) {
+  std::vector<std::unique_ptr<Mutant>> mutants;
+  for (int line = 1; line <= count; line++) {
+    SourceLocation location("/src", "file.cpp", "/src", "file.cpp", line, 1);
+    mutants.push_back(std::make_unique<Mutant>(
+        "cxx_add_to_sub:file.cpp:" + std::to_string(line) + ":1",
+        "cxx_add_to_sub",
+        location,
+        location,
+        line != count));
+  }
+  return mutants;
+}
+
+/// Line 1 is as expensive as all the other mutants together
+static long long cost(const Mutant &mutant) {
+  if (!mutant.isCovered()) {
+    return 0;
+  }
+  return mutant.getSourceLocation().line == 1 ? 8 : 1;
+}
+
+TEST(Sharding, SplitsMutantsByCost) {
+  std::vector<int> firstShard;
+  std::vector<int> secondShard;
+  for (auto &mutant : selectShard(makeMutants(10), cost, 0, 2)) {
+    firstShard.push_back(mutant->getSourceLocation().line);
+  }
+  for (auto &mutant : selectShard(makeMutants(10), cost, 1, 2)) {
+    secondShard.push_back(mutant->getSourceLocation().line);
+  }
+
+  /// The shards do not overlap, cover all the mutants, and keep the original order
+  ASSERT_EQ(firstShard, std::vector<int>({ 1, 10 }));
+  ASSERT_EQ(secondShard, std::vector<int>({ 2, 3, 4, 5, 6, 7, 8, 9 }));
+
+  ASSERT_EQ(selectShard(makeMutants(10), cost, 0, 1).size(), 10U);
+}
+
+/// Runs the shard selected from the given number of mutants and writes its partial result
+static std::string writeShard(Diagnostics &diagnostics, const std::string &directory,
+                              unsigned shard, int mutantCount) {
+  auto mutants = selectShard(makeMutants(mutantCount), cost, shard, 2);
+  std::vector<std::unique_ptr<MutationResult>> results;
+  for (auto &mutant : mutants) {
+    ExecutionResult executionResult;
+    executionResult.status = mutant->isCovered() ? Failed : NotCovered;
+    executionResult.stderrOutput = "killed by shard " + std::to_string(shard);
+    results.push_back(std::make_unique<MutationResult>(executionResult, mutant.get()));
+  }
+  Result result(std::move(mutants), std::move(results));
+  std::string path = partialResultPath(directory, "", shard, 2);
+  writePartialResult(
+      diagnostics, path, result, shard, 2, describeMutants(makeMutants(mutantCount)));
+  return path;
+}
+
+TEST(Sharding, MergesPartialResults) {
+  Diagnostics diagnostics;
+  llvm::SmallString<128> directory;
+  llvm::sys::fs::createUniqueDirectory("mull-sharding", directory);
+
+  std::vector<std::string> paths;
+  for (unsigned shard = 0; shard < 2; shard++) {
+    paths.push_back(writeShard(diagnostics, directory.str().str(), shard, 4));
+  }
+  ASSERT_EQ(llvm::sys::path::filename(paths.back()).str(), "mull-shard-1-of-2.sqlite");
+
+  std::unique_ptr<Result> merged = mergePartialResults(diagnostics, paths);
+  ASSERT_EQ(merged->getMutants().size(), 4U);
+  ASSERT_EQ(merged->getMutationResults().size(), 4U);
+  for (int index = 0; index < 4; index++) {
+    auto &mutant = merged->getMutants()[index];
+    auto &mutationResult = merged->getMutationResults()[index];
+    ASSERT_EQ(mutant->getSourceLocation().line, index + 1);
+    ASSERT_EQ(mutant->getEndLocation().unitFilePath, "file.cpp");
+    ASSERT_EQ(mutationResult->getMutant(), mutant.get());
+    ASSERT_EQ(mutationResult->getExecutionResult().status, index == 3 ? NotCovered : Failed);
+  }
+  ASSERT_EQ(merged->getMutationResults()[0]->getExecutionResult().stderrOutput,
+            "killed by shard 0");
+
+  llvm::sys::fs::remove_directories(directory);
+}
+
+TEST(Sharding, FailsOnIncompletePartialResults) {
+  Diagnostics diagnostics;
+  llvm::SmallString<128> directory;
+  llvm::sys::fs::createUniqueDirectory("mull-sharding", directory);
+
+  std::string firstShard = writeShard(diagnostics, directory.str().str(), 0, 4);
+  /// The second shard is missing
+  ASSERT_EXIT(mergePartialResults(diagnostics, { firstShard }),
+              ::testing::ExitedWithCode(1),
+              "");
+  /// The second shard was selected from a different list of mutants
+  std::string secondShard = writeShard(diagnostics, directory.str().str(), 1, 5);
+  ASSERT_EXIT(mergePartialResults(diagnostics, { firstShard, secondShard }),
+              ::testing::ExitedWithCode(1),
+              "");
+
+  llvm::sys::fs::remove_directories(directory);
+}
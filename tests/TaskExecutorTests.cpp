@@ -115,3 +115,74 @@ TEST(TaskExecutor, SequentialExecution_EmptyTask_MoreWorkers) {
 
   ASSERT_EQ(expected, out);
 }
+
+TEST(TaskExecutor, DynamicExecution_AddNumber_PreservesOrder) {
+  Diagnostics diagnostics;
+  int workers = 4;
+  std::vector<AddNumberTask> tasks;
+  for (int i = 0; i < workers; i++) {
+    tasks.emplace_back(AddNumberTask());
+  }
+
+  std::vector<int> in;
+  std::vector<int> expected;
+  for (int i = 0; i < 100; i++) {
+    in.push_back(i);
+    expected.push_back(i + 1);
+  }
+  std::vector<int> out;
+
+  TaskExecutor<AddNumberTask> executor(
+      diagnostics, "increment numbers", in, out, std::move(tasks), TaskScheduling::Dynamic);
+  executor.execute();
+
+  ASSERT_EQ(size_t(100), in.size());
+  ASSERT_EQ(size_t(100), out.size());
+
+  ASSERT_EQ(expected, out);
+}
+
+TEST(TaskExecutor, DynamicExecution_EmptyTask_MoreWorkers) {
+  Diagnostics diagnostics;
+  int workers = 4;
+  std::vector<EmptyTask> tasks;
+  for (int i = 0; i < workers; i++) {
+    tasks.emplace_back(EmptyTask());
+  }
+
+  std::vector<int> in({ 1, 2, 3 });
+  std::vector<int> out;
+  std::vector<int> expected;
+
+  TaskExecutor<EmptyTask> executor(
+      diagnostics, "do nothing", in, out, std::move(tasks), TaskScheduling::Dynamic);
+  executor.execute();
+
+  ASSERT_EQ(size_t(3), in.size());
+  ASSERT_EQ(size_t(0), out.size());
+
+  ASSERT_EQ(expected, out);
+}
+
+TEST(TaskExecutor, ThreadPoolExecution_AddNumber_SharedAcrossExecutors) {
+  Diagnostics diagnostics;
+  int workers = 4;
+  ThreadPool threadPool(workers);
+
+  for (auto scheduling : { TaskScheduling::StaticBatches, TaskScheduling::Dynamic }) {
+    std::vector<AddNumberTask> tasks;
+    for (int i = 0; i < workers; i++) {
+      tasks.emplace_back(AddNumberTask());
+    }
+
+    std::vector<int> in({ 1, 2, 3, 4, 5, 6 });
+    std::vector<int> out;
+    std::vector<int> expected({ 2, 3, 4, 5, 6, 7 });
+
+    TaskExecutor<AddNumberTask> executor(
+        diagnostics, "increment numbers", in, out, std::move(tasks), scheduling);
+    executor.execute(&threadPool);
+
+    ASSERT_EQ(expected, out);
+  }
+}
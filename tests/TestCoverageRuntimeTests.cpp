@@ -0,0 +1,71 @@
+#include "mull/Runtime/TestCoverageRuntime.h"
+
+#include <gtest/gtest.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Support/SourceMgr.h>
+
+using namespace mull;
+
+static std::string record(const std::string &lines, const std::string &flags, size_t linesCount) {
+  return std::string(TestCoverageMarker) + std::to_string(flags.size()) + " " +
+         std::to_string(linesCount) + "\n" + lines + flags;
+}
+
+TEST(TestCoverageRuntime, MutantsAreReachedOnceTheirFlagIsSet) {
+  /// Each module appends its own record, the identifiers may contain spaces
+  std::string contents = record("0 first\n0 second\n1 third mutant\n", std::string({ 1, 0 }), 3) +
+                         record("0 fourth\n1 fifth\n", std::string({ 0, 1 }), 2);
+  std::vector<std::string> identifiers;
+  ASSERT_TRUE(parseTestCoverage(contents, identifiers));
+  ASSERT_EQ(identifiers, std::vector<std::string>({ "first", "second", "fifth" }));
+
+  identifiers.clear();
+  ASSERT_TRUE(parseTestCoverage("", identifiers));
+  ASSERT_TRUE(identifiers.empty());
+}
+
+TEST(TestCoverageRuntime, RejectsMalformedRecords) {
+  std::vector<std::string> identifiers;
+  /// The record was cut short before its flags
+  std::string truncated = record("0 first\n1 second\n", std::string({ 1, 1 }), 2);
+  truncated.pop_back();
+  ASSERT_FALSE(parseTestCoverage(truncated, identifiers));
+  ASSERT_FALSE(
+      parseTestCoverage(record("0 first\n", std::string({ 1 }), 1) + "garbage", identifiers));
+  ASSERT_FALSE(parseTestCoverage(record("2 first\n", std::string({ 1, 1 }), 1), identifiers));
+}
+
+TEST(TestCoverageRuntime, InsertsProbesIntoTrampolines) {
+  llvm::LLVMContext context;
+  llvm::SMDiagnostic error;
+  std::unique_ptr<llvm::Module> module = llvm::parseAssemblyString(R"(
+define i32 @first() {
+  ret i32 1
+}
+define i32 @second() {
+  ret i32 2
+}
+)",
+                                                                   error,
+                                                                   context);
+  ASSERT_NE(module, nullptr);
+  llvm::Function *first = module->getFunction("first");
+  llvm::Function *second = module->getFunction("second");
+
+  insertTestCoverage(*module, { { first, { "a", "b" } }, { second, { "c" } } });
+  ASSERT_FALSE(llvm::verifyModule(*module, &llvm::errs()));
+
+  /// A probe is a load of the flags, a GEP, and a store at the entry of the trampoline
+  for (llvm::Function *function : { first, second }) {
+    llvm::Instruction *probe = &function->getEntryBlock().front();
+    ASSERT_TRUE(llvm::isa<llvm::LoadInst>(probe));
+    ASSERT_TRUE(llvm::isa<llvm::StoreInst>(probe->getNextNode()->getNextNode()));
+  }
+
+  ASSERT_NE(module->getFunction("mull_map_test_coverage"), nullptr);
+  ASSERT_NE(module->getNamedGlobal("llvm.global_ctors"), nullptr);
+}
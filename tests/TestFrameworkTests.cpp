@@ -0,0 +1,87 @@
+#include "FixturePaths.h"
+#include "mull/Toolchain/TestFramework.h"
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Toolchain/Runner.h"
+
+#include <gtest/gtest.h>
+
+using namespace mull;
+
+TEST(TestFramework, GoogleTest) {
+  TestFramework framework(TestFrameworkKind::GoogleTest);
+
+  const std::string output = std::string(R"(Running main() from gtest_main.cc
+Math.
+  Add
+  Sub
+Params/Math.
+  Mul/0  # GetParam() = 42
+)");
+
+  std::vector<std::string> tests = framework.parseTestList(output);
+  ASSERT_EQ(tests, std::vector<std::string>({ "Math.Add", "Math.Sub", "Params/Math.Mul/0" }));
+  ASSERT_EQ(framework.selectArguments({ "Math.Add", "Math.Sub" }),
+            std::vector<std::string>({ "--gtest_filter=Math.Add:Math.Sub" }));
+}
+
+TEST(TestFramework, Catch2) {
+  TestFramework framework(TestFrameworkKind::Catch2);
+
+  std::vector<std::string> tests = framework.parseTestList("Adds numbers\nScenario: [a], b\n\n");
+  ASSERT_EQ(tests, std::vector<std::string>({ "Adds numbers", "Scenario: [a], b" }));
+  ASSERT_EQ(framework.selectArguments(tests),
+            std::vector<std::string>({ "Adds numbers,Scenario: \\[a\\]\\, b" }));
+}
+
+TEST(TestFramework, Catch2ListingArguments) {
+  TestFramework framework(TestFrameworkKind::Catch2);
+
+  /// Catch2 v2 first, v3 dropped its option
+  ASSERT_EQ(framework.listArguments(),
+            std::vector<std::vector<std::string>>(
+                { { "--list-test-names-only" }, { "--list-tests", "--verbosity", "quiet" } }));
+  /// Both versions quote the names starting with '#'
+  ASSERT_EQ(framework.parseTestList("\"#1 test\"\n"), std::vector<std::string>({ "#1 test" }));
+}
+
+#ifdef MULL_CATCH2_FIXTURE
+TEST(TestFramework, ListsAndSelectsCatch2Tests) {
+  Diagnostics diagnostics;
+  Runner runner(diagnostics);
+  TestFramework framework(TestFrameworkKind::Catch2);
+  const std::string program = fixtures::test_frameworks_catch2_exe_path();
+
+  std::vector<std::string> tests = framework.listTests(runner, program, {}, 5000);
+  ASSERT_EQ(tests,
+            std::vector<std::string>(
+                { "adds numbers", "subtracts [negative] numbers", "fails, on purpose" }));
+
+  auto run = [&](const std::vector<std::string> &selected) {
+    return runner
+        .runProgram(program, framework.selectArguments(selected), {}, 5000, true, std::nullopt)
+        .status;
+  };
+  ASSERT_EQ(run({ "adds numbers", "subtracts [negative] numbers" }), Passed);
+  ASSERT_EQ(run({ "fails, on purpose" }), Failed);
+}
+#endif
+
+TEST(TestFramework, Doctest) {
+  TestFramework framework(TestFrameworkKind::Doctest);
+
+  const std::string output = std::string(R"([doctest] doctest version is "2.4.6"
+[doctest] run with "--help" for options
+===============================================================================
+[doctest] listing all test case names
+===============================================================================
+adds numbers
+a, b
+===============================================================================
+[doctest] unskipped test cases passing the current filters: 2
+)");
+
+  std::vector<std::string> tests = framework.parseTestList(output);
+  ASSERT_EQ(tests, std::vector<std::string>({ "adds numbers", "a, b" }));
+  ASSERT_EQ(framework.selectArguments(tests),
+            std::vector<std::string>({ "--test-case=adds numbers,a? b" }));
+}
@@ -0,0 +1,30 @@
+#include "mull/TestHistory.h"
+
+#include "DatabaseTest.h"
+
+#include <gtest/gtest.h>
+
+using namespace mull;
+
+using TestHistoryTest = DatabaseTest;
+
+TEST_F(TestHistoryTest, PrioritizesKillersAcrossRuns) {
+  std::vector<std::string> tests({ "slow", "fast", "killer" });
+  std::unordered_map<std::string, long long> durations(
+      { { "slow", 100 }, { "fast", 10 }, { "killer", 10 } });
+
+  auto empty = loadStore<TestHistory>();
+  ASSERT_EQ(empty->prioritize("mutant", tests, durations),
+            std::vector<std::string>({ "fast", "killer", "slow" }));
+
+  empty->recordRun("mutant", "fast", false);
+  empty->recordRun("mutant", "killer", true);
+  empty->recordRun("other", "slow", true);
+
+  auto history = reload(*empty);
+  ASSERT_EQ(history->prioritize("mutant", tests, durations),
+            std::vector<std::string>({ "killer", "fast", "slow" }));
+  /// No history for this mutant: the overall kill rates are used
+  ASSERT_EQ(history->prioritize("new", { "slow", "fast" }, { { "slow", 1 }, { "fast", 1 } }),
+            std::vector<std::string>({ "slow", "fast" }));
+}
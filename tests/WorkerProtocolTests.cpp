@@ -0,0 +1,53 @@
+#include "mull/Toolchain/WorkerProtocol.h"
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+using namespace mull;
+
+TEST(WorkerProtocol, EncodesFramesWithBinaryFields) {
+  WorkerFrame frame({ "run", "cxx_add_to_sub:file.cpp:1:2", "", std::string("a\0b\n", 4) });
+  std::string encoded = encodeWorkerFrame(frame);
+  /// 4 length prefixes and 34 bytes of fields
+  ASSERT_EQ(encoded.substr(0, 4), std::string("\0\0\0\x32", 4));
+  ASSERT_EQ(encoded.size(), 4U + 50U);
+
+  WorkerFrame decoded;
+  ASSERT_TRUE(decodeWorkerFrame(encoded.substr(4), decoded));
+  ASSERT_EQ(decoded, frame);
+
+  /// The last field claims more bytes than there are
+  ASSERT_FALSE(decodeWorkerFrame(encoded.substr(4, encoded.size() - 5), decoded));
+}
+
+TEST(WorkerProtocol, SendsResultsThroughPipe) {
+  int descriptors[2];
+  ASSERT_EQ(pipe(descriptors), 0);
+
+  ExecutionResult result;
+  result.status = Timedout;
+  result.exitStatus = 9;
+  result.runningTime = 1234;
+  result.stdoutOutput = "out";
+  result.stderrOutput = "err\n";
+  ASSERT_TRUE(writeWorkerFrame(descriptors[1], makeResultFrame("mutant", result)));
+
+  WorkerFrame frame;
+  ASSERT_TRUE(readWorkerFrame(descriptors[0], frame, 1000));
+  std::string mutant;
+  ExecutionResult received;
+  ASSERT_TRUE(parseResultFrame(frame, mutant, received));
+  ASSERT_EQ(mutant, "mutant");
+  ASSERT_EQ(received.status, Timedout);
+  ASSERT_EQ(received.exitStatus, 9);
+  ASSERT_EQ(received.runningTime, 1234);
+  ASSERT_EQ(received.stdoutOutput, "out");
+  ASSERT_EQ(received.stderrOutput, "err\n");
+
+  /// Nothing else was sent
+  ASSERT_FALSE(readWorkerFrame(descriptors[0], frame, 10));
+  ASSERT_FALSE(parseResultFrame({ "hello", "1" }, mutant, received));
+
+  close(descriptors[0]);
+  close(descriptors[1]);
+}
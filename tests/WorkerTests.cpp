@@ -0,0 +1,76 @@
+#include "mull/Config/Configuration.h"
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Mutant.h"
+#include "mull/MutationResult.h"
+#include "mull/Parallelization/Progress.h"
+#include "mull/Parallelization/Tasks/MutantExecutionTask.h"
+#include "mull/SourceLocation.h"
+
+#include <gtest/gtest.h>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/raw_ostream.h>
+
+using namespace mull;
+
+/// Tells where it runs, kills the worker running it when crash_worker is enabled,
+/// and fails when killed is enabled
+static const char *Program = R"(#!/bin/sh
+if [ -n "$MULL_TEST_WORKER" ]; then
+  echo worker
+  if [ "$crash_worker" = 1 ]; then
+    kill -9 $PPID
+    sleep 1
+  fi
+else
+  echo local
+fi
+if [ "$killed" = 1 ]; then
+  exit 1
+fi
+)";
+
+TEST(Worker, RunsMutantsLocallyOnceWorkerIsGone) {
+  llvm::SmallString<128> programPath;
+  int descriptor;
+  ASSERT_FALSE(
+      llvm::sys::fs::createTemporaryFile("mull-worker-program", "sh", descriptor, programPath));
+  {
+    llvm::raw_fd_ostream stream(descriptor, true);
+    stream << Program;
+  }
+  llvm::sys::fs::setPermissions(programPath, llvm::sys::fs::all_read | llvm::sys::fs::all_exe);
+  std::string program = programPath.str().str();
+
+  std::vector<std::unique_ptr<Mutant>> mutants;
+  for (const char *identifier : { "killed", "crash_worker", "survivor" }) {
+    mutants.push_back(std::make_unique<Mutant>(identifier,
+                                               "mutator",
+                                               SourceLocation::nullSourceLocation(),
+                                               SourceLocation::nullSourceLocation(),
+                                               true));
+  }
+
+  Configuration configuration;
+  Diagnostics diagnostics;
+  ExecutionResult baseline;
+  baseline.runningTime = 1000;
+  std::vector<std::string> extraArgs;
+  /// Only the worker and the programs it runs see the variable
+  std::string workerCommand = "MULL_TEST_WORKER=1 exec " MULL_WORKER_PATH;
+  MutantExecutionTask task(
+      configuration, diagnostics, program, baseline, extraArgs, nullptr, workerCommand);
+  std::vector<std::unique_ptr<MutationResult>> results;
+  progress_counter counter;
+  task(mutants.begin(), mutants.end(), results, counter);
+  llvm::sys::fs::remove(program);
+
+  ASSERT_EQ(results.size(), 3U);
+  ASSERT_EQ(results[0]->getExecutionResult().status, Failed);
+  ASSERT_EQ(results[0]->getExecutionResult().stdoutOutput, "worker\n");
+  /// The worker dies in the middle of the mutant, which then runs locally
+  ASSERT_EQ(results[1]->getExecutionResult().status, Passed);
+  ASSERT_EQ(results[1]->getExecutionResult().stdoutOutput, "local\n");
+  ASSERT_EQ(results[2]->getExecutionResult().status, Passed);
+  ASSERT_EQ(results[2]->getExecutionResult().stdoutOutput, "local\n");
+}
@@ -0,0 +1,6 @@
+extern int sum(int, int);
+extern int product(int, int);
+
+int main() {
+  return sum(2, 3) == product(1, 5) ? 0 : 1;
+}
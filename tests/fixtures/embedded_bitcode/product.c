@@ -0,0 +1,3 @@
+int product(int a, int b) {
+  return a * b;
+}
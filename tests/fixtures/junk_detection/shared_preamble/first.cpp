@@ -0,0 +1,9 @@
+#include "shared.h"
+
+int sum(int a, int b) {
+  return a + b;
+}
+
+int incremented(int a) {
+  return INCREMENT(a);
+}
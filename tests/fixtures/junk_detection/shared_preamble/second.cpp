@@ -0,0 +1,5 @@
+#include "shared.h"
+
+int sumOfDoubles(int a, int b) {
+  return twice(a) + twice(b);
+}
@@ -0,0 +1,10 @@
+#ifndef SHARED_H
+#define SHARED_H
+
+#define INCREMENT(x) ((x) + 1)
+
+static inline int twice(int x) {
+  return x + x;
+}
+
+#endif
@@ -0,0 +1,18 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+static int sum(int a, int b) {
+  return a + b;
+}
+
+TEST_CASE("adds numbers") {
+  REQUIRE(sum(2, 3) == 5);
+}
+
+TEST_CASE("subtracts [negative] numbers") {
+  REQUIRE(sum(2, -3) == -1);
+}
+
+TEST_CASE("fails, on purpose") {
+  REQUIRE(sum(2, 2) == 5);
+}
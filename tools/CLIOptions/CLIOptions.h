@@ -87,6 +87,31 @@ opt<bool> DisableJunkDetection( \
     init(false), \
     cat(MullCategory))
 
+#define DetectEquivalentMutants_() \
+opt<bool> DetectEquivalentMutants( \
+    "detect-equivalent-mutants", \
+    desc("Optimizes each mutated function and compares it with the original one and with the other mutants. Mutants identical to the original code are dropped, identical mutants run once and share the result. Disabled by default"), \
+    Optional, \
+    init(false), \
+    cat(MullCategory))
+
+#define JunkCache_() \
+opt<std::string> JunkCache( \
+    "junk-cache", \
+    desc("SQLite file where the junk detection results are kept between runs. A translation unit is not parsed again if neither its contents, the files it includes, nor its compilation flags changed. Disabled by default"), \
+    Optional, \
+    value_desc("filename"), \
+    init(""), \
+    cat(MullCategory))
+
+#define PruneEquivalentMutants_() \
+opt<bool> PruneEquivalentMutants( \
+    "prune-equivalent-mutants", \
+    desc("Removes the mutants that are equivalent by construction before they are compiled: x + 0 to x - 0, x * 1 to x / 1, shifts by zero, x & x to x | x, comparisons folding to the same value. Reports how many mutants each rule removed. Disabled by default"), \
+    Optional, \
+    init(false), \
+    cat(MullCategory))
+
 #define CompilationDatabasePath_() \
 opt<std::string> CompilationDatabasePath( \
     "compdb-path", \
@@ -121,6 +146,48 @@ opt<std::string> LinkerFlags( \
     init(std::string()), \
     cat(MullCategory))
 
+#define CodegenProfileOption_() \
+opt<std::string> CodegenProfileOption( \
+    "codegen-profile", \
+    desc("How to compile the mutated program: default, fast-compile, fast-run, or auto (picks one of the two based on estimated compilation and execution time)"), \
+    Optional, \
+    value_desc("profile"), \
+    init("default"), \
+    cat(MullCategory))
+
+#define TestFrameworkOption_() \
+opt<std::string> TestFrameworkOption( \
+    "test-framework", \
+    desc("Runs each mutant only against the tests that reach it: gtest, catch2 (v2 or v3), or doctest. Disabled by default"), \
+    Optional, \
+    value_desc("framework"), \
+    init("none"), \
+    cat(MullCategory))
+
+#define PrioritizeTests_() \
+opt<bool> PrioritizeTests( \
+    "prioritize-tests", \
+    desc("Runs the tests of each mutant one by one, the likely killers first, and stops at the first failure. Requires -test-framework. The kill history is kept in mull-test-history.sqlite in the report directory. Disabled by default"), \
+    Optional, \
+    init(false), \
+    cat(MullCategory))
+
+#define Subsumption_() \
+opt<bool> Subsumption( \
+    "subsumption", \
+    desc("Runs the tests of each mutant one by one and records which of them kill it into mull-kill-matrix.sqlite in the report directory. The next runs execute the subsumed mutants only if the mutants subsuming them survive, otherwise their status is inferred. Requires -test-framework. Disabled by default"), \
+    Optional, \
+    init(false), \
+    cat(MullCategory))
+
+#define InProcessLinker_() \
+opt<bool> InProcessLinker( \
+    "in-process-linker", \
+    desc("Links the mutated program with the built-in lld (ELF only) instead of spawning -linker. The object files are still written to the disk, only the spawn of the linker is saved. If -linker is a compiler driver, its link command is computed with the flags of -linker-flags, otherwise the flags are passed to lld as is. -linker-timeout does not apply. Disabled by default"), \
+    Optional, \
+    init(false), \
+    cat(MullCategory))
+
 #define LinkerTimeout_() \
 opt<unsigned> LinkerTimeout( \
     "linker-timeout", \
@@ -139,6 +206,14 @@ opt<std::string> CoverageInfo( \
     init(std::string()), \
     cat(MullCategory))
 
+#define ReachabilityProbes_() \
+opt<bool> ReachabilityProbes( \
+    "reachability-probes", \
+    desc("Probe which mutants the baseline run executes, the mutants the tests never reach are reported as not covered without being run. Disabled by default"), \
+    Optional, \
+    init(false), \
+    cat(MullCategory))
+
 #define DryRunOption_() \
 opt<bool> DryRunOption( \
     "dry-run", \
@@ -155,6 +230,22 @@ opt<bool> MutateOnly( \
     init(false), \
     cat(MullCategory))
 
+#define ForkServerOption_() \
+opt<bool> ForkServerOption( \
+    "fork-server", \
+    desc("Starts the mutated program once and forks it for each mutant. Output of mutants is not captured. Disabled by default"), \
+    Optional, \
+    init(false), \
+    cat(MullCategory))
+
+#define MutantSchemata_() \
+opt<bool> MutantSchemata( \
+    "mutant-schemata", \
+    desc("Puts the mutants of a function into a single mutated function and selects the active one at runtime. Disabled by default"), \
+    Optional, \
+    init(false), \
+    cat(MullCategory))
+
 #define Mutators_() \
 list<MutatorsOptionIndex> Mutators( \
     "mutators", \
@@ -191,6 +282,67 @@ opt<bool> KeepExecutable( \
     llvm::cl::desc("Keep temporary executable file"), \
     llvm::cl::cat(MullCategory), llvm::cl::init(false))
 
+#define ResultCacheOption_() \
+opt<std::string> ResultCacheOption( \
+    "result-cache", \
+    desc("SQLite file where the mutant results are kept between runs. A mutant reuses its previous result if neither its function, the callees, nor the rest of the program changed. Disabled by default"), \
+    Optional, \
+    value_desc("filename"), \
+    init(""), \
+    cat(MullCategory))
+
+#define MemoryBudget_() \
+opt<unsigned> MemoryBudget( \
+    "memory-budget", \
+    desc("Processes the program in batches of modules that fit into the budget (megabytes). Disabled by default"), \
+    Optional, \
+    value_desc("number"), \
+    init(0), \
+    cat(MullCategory))
+
+#define WorkerCommands_() \
+list<std::string> WorkerCommands( \
+    "worker", \
+    desc("Shell command that starts a mutant execution worker, e.g. 'ssh agent mull-worker'. Repeat to make a pool, each worker runs one mutant at a time. The program must exist at the same path on the worker's machine. Disabled by default"), \
+    ZeroOrMore, \
+    value_desc("command"), \
+    cat(MullCategory))
+
+#define ShardIndex_() \
+opt<unsigned> ShardIndex( \
+    "shard-index", \
+    desc("Which shard of the mutants to run, from 0 to -shard-count minus 1"), \
+    Optional, \
+    value_desc("number"), \
+    init(0), \
+    cat(MullCategory))
+
+#define ShardCount_() \
+opt<unsigned> ShardCount( \
+    "shard-count", \
+    desc("Splits the mutants into shards with similar numbers of covered mutants, runs only the one given by -shard-index, and saves its partial result into <report-name>-shard-<index>-of-<count>.sqlite in the report directory. Use mull-merge to combine the partial results. Disabled by default"), \
+    Optional, \
+    value_desc("number"), \
+    init(0), \
+    cat(MullCategory))
+
+#define PartialResults_() \
+list<std::string> PartialResults( \
+    Positional, \
+    desc("<partial results>"), \
+    OneOrMore, \
+    value_desc("path"), \
+    cat(MullCategory))
+
+#define CacheDirectory_() \
+opt<std::string> CacheDirectory( \
+    "cache-dir", \
+    desc("Where to cache compiled object files between runs. Disabled by default"), \
+    Optional, \
+    value_desc("directory"), \
+    init(std::string()), \
+    cat(MullCategory))
+
 #define GitDiffRef_() \
 opt<std::string> GitDiffRef( \
     "git-diff-ref", \
@@ -26,10 +26,16 @@ DryRunOption_();
 Linker_();
 LinkerFlags_();
 LinkerTimeout_();
+InProcessLinker_();
+CodegenProfileOption_();
 CoverageInfo_();
+ReachabilityProbes_();
 IncludeNotCovered_();
 KeepExecutable_();
 KeepObjectFiles_();
+CacheDirectory_();
+ResultCacheOption_();
+MemoryBudget_();
 CompilationDatabasePath_();
 CompilationFlags_();
 ExcludePaths_();
@@ -37,8 +43,19 @@ IncludePaths_();
 GitDiffRef_();
 GitProjectRoot_();
 DisableJunkDetection_();
+DetectEquivalentMutants_();
+PruneEquivalentMutants_();
+JunkCache_();
 IDEReporterShowKilled_();
 MutateOnly_();
+ForkServerOption_();
+MutantSchemata_();
+TestFrameworkOption_();
+PrioritizeTests_();
+Subsumption_();
+WorkerCommands_();
+ShardIndex_();
+ShardCount_();
 
 void dumpCLIInterface(Diagnostics &diagnostics) {
   // Enumerating CLI options explicitly to control the order and what to show
@@ -49,8 +66,17 @@ void dumpCLIInterface(Diagnostics &diagnostics) {
 
       &Workers,
       &Timeout,
+      &MemoryBudget,
       &DryRunOption,
       &MutateOnly,
+      &ForkServerOption,
+      &MutantSchemata,
+      &TestFrameworkOption,
+      &PrioritizeTests,
+      &Subsumption,
+      &(Option &)WorkerCommands,
+      &ShardIndex,
+      &ShardCount,
 
       &ReportName,
       &ReportDirectory,
@@ -61,21 +87,29 @@ void dumpCLIInterface(Diagnostics &diagnostics) {
 
       &KeepObjectFiles,
       &KeepExecutable,
+      &CacheDirectory,
+      &ResultCacheOption,
 
       &NoTestOutput,
       &NoMutantOutput,
       &NoOutput,
 
       &DisableJunkDetection,
+      &DetectEquivalentMutants,
+      &PruneEquivalentMutants,
+      &JunkCache,
       &CompilationDatabasePath,
       &CompilationFlags,
 
       &Linker,
       &LinkerFlags,
       &LinkerTimeout,
+      &InProcessLinker,
+      &CodegenProfileOption,
 
       &CoverageInfo,
       &IncludeNotCovered,
+      &ReachabilityProbes,
 
       &(Option &)IncludePaths,
       &(Option &)ExcludePaths,
@@ -5,11 +5,13 @@
 #include <llvm/Support/TargetSelect.h>
 
 #include "mull-cxx-cli.h"
+#include "mull/BitcodeExtractor.h"
 #include "mull/BitcodeMetadataReader.h"
 #include "mull/Config/Configuration.h"
 #include "mull/Config/ConfigurationOptions.h"
 #include "mull/Diagnostics/Diagnostics.h"
 #include "mull/Driver.h"
+#include "mull/Filters/EquivalentMutationFilter.h"
 #include "mull/Filters/FilePathFilter.h"
 #include "mull/Filters/Filter.h"
 #include "mull/Filters/Filters.h"
@@ -17,13 +19,17 @@
 #include "mull/Filters/JunkMutationFilter.h"
 #include "mull/Filters/NoDebugInfoFilter.h"
 #include "mull/JunkDetection/CXX/CXXJunkDetector.h"
+#include "mull/JunkDetection/CXX/CachedJunkDetector.h"
+#include "mull/JunkDetection/IRJunkDetector.h"
 #include "mull/Metrics/MetricsMeasure.h"
 #include "mull/MutationsFinder.h"
 #include "mull/Parallelization/Tasks/LoadBitcodeFromBinaryTask.h"
 #include "mull/Program/Program.h"
 #include "mull/Result.h"
+#include "mull/Sharding.h"
 #include "mull/Version.h"
 
+#include <csignal>
 #include <iterator>
 #include <memory>
 #include <sstream>
@@ -50,6 +56,9 @@ static std::vector<std::string> splitFlags(const std::string &flags) {
 }
 
 int main(int argc, char **argv) {
+  /// A dead worker or fork server must not kill Mull, broken pipes are reported by write()
+  signal(SIGPIPE, SIG_IGN);
+
   mull::Diagnostics diagnostics;
   llvm::cl::SetVersionPrinter(mull::printVersionInformation);
 
@@ -101,6 +110,14 @@ int main(int argc, char **argv) {
   configuration.linker = tool::Linker.getValue();
   configuration.linkerFlags = splitFlags(tool::LinkerFlags.getValue());
   configuration.linkerTimeout = tool::LinkerTimeout.getValue();
+  configuration.memoryBudget = tool::MemoryBudget.getValue();
+  configuration.inProcessLinker = tool::InProcessLinker.getValue();
+
+  std::string codegenProfile = tool::CodegenProfileOption.getValue();
+  if (!mull::parseCodegenProfile(codegenProfile, configuration.codegenProfile)) {
+    diagnostics.error(std::string("Unknown codegen profile '") + codegenProfile +
+                      "', expected one of: default, fast-compile, fast-run, auto");
+  }
 
   configuration.debugEnabled = tool::DebugEnabled;
   configuration.timeout = tool::Timeout.getValue();
@@ -109,9 +126,59 @@ int main(int argc, char **argv) {
   configuration.outputFile = tool::OutputFile.getValue();
   configuration.coverageInfo = tool::CoverageInfo.getValue();
   configuration.includeNotCovered = tool::IncludeNotCovered.getValue();
+  configuration.reachabilityProbes = tool::ReachabilityProbes.getValue();
+
+  configuration.forkServer = tool::ForkServerOption.getValue();
+  configuration.mutantSchemata = tool::MutantSchemata.getValue();
+  configuration.detectEquivalentMutants = tool::DetectEquivalentMutants.getValue();
+  configuration.workerCommands.assign(tool::WorkerCommands.begin(), tool::WorkerCommands.end());
+
+  std::string testFramework = tool::TestFrameworkOption.getValue();
+  if (testFramework == "gtest") {
+    configuration.testFramework = mull::TestFrameworkKind::GoogleTest;
+  } else if (testFramework == "catch2") {
+    configuration.testFramework = mull::TestFrameworkKind::Catch2;
+  } else if (testFramework == "doctest") {
+    configuration.testFramework = mull::TestFrameworkKind::Doctest;
+  } else if (testFramework != "none") {
+    diagnostics.warning(std::string("Unknown test framework '") + testFramework +
+                        "', running the whole test program for each mutant");
+  }
+  if (tool::PrioritizeTests) {
+    if (configuration.testFramework == mull::TestFrameworkKind::None) {
+      diagnostics.warning("-prioritize-tests requires -test-framework, ignoring it");
+    } else {
+      std::string reportDirectory = tool::ReportDirectory.getValue();
+      if (reportDirectory.empty()) {
+        reportDirectory = ".";
+      }
+      configuration.testHistory = reportDirectory + "/mull-test-history.sqlite";
+    }
+  }
+  if (tool::Subsumption) {
+    if (configuration.testFramework == mull::TestFrameworkKind::None) {
+      diagnostics.warning("-subsumption requires -test-framework, ignoring it");
+    } else {
+      std::string reportDirectory = tool::ReportDirectory.getValue();
+      if (reportDirectory.empty()) {
+        reportDirectory = ".";
+      }
+      configuration.killMatrix = reportDirectory + "/mull-kill-matrix.sqlite";
+    }
+  }
 
   configuration.keepObjectFiles = tool::KeepObjectFiles.getValue();
   configuration.keepExecutable = tool::KeepExecutable.getValue();
+  configuration.cacheDirectory = tool::CacheDirectory.getValue();
+  configuration.resultCache = tool::ResultCacheOption.getValue();
+
+  if (tool::ShardCount > 1) {
+    if (tool::ShardIndex >= tool::ShardCount) {
+      diagnostics.error("-shard-index must be less than -shard-count");
+    }
+    configuration.shardIndex = tool::ShardIndex;
+    configuration.shardCount = tool::ShardCount;
+  }
 
   if (tool::Workers) {
     mull::ParallelizationConfig parallelizationConfig;
@@ -129,9 +196,18 @@ int main(int argc, char **argv) {
     configuration.captureMutantOutput = false;
   }
 
+  /// The bitcode buffers point into the executable or into the embedded files, both must outlive
+  /// the program
+  mull::BitcodeExtractor bitcodeExtractor(diagnostics);
   std::vector<std::unique_ptr<ebc::EmbeddedFile>> embeddedFiles;
+  std::vector<llvm::MemoryBufferRef> bitcodeBuffers;
   mull::SingleTaskExecutor extractBitcodeBuffers(diagnostics);
   extractBitcodeBuffers.execute("Extracting bitcode from executable", [&] {
+    bitcodeBuffers = bitcodeExtractor.extractBitcode(inputFile);
+    if (!bitcodeBuffers.empty()) {
+      return;
+    }
+    /// Bitcode bundles (xar archives) are only supported by ebc
     ebc::BitcodeRetriever bitcodeRetriever(inputFile);
     for (auto &bitcodeInfo : bitcodeRetriever.GetBitcodeInfo()) {
       auto &container = bitcodeInfo.bitcodeContainer;
@@ -143,23 +219,37 @@ int main(int argc, char **argv) {
         diagnostics.warning(std::string("No bitcode: ") + bitcodeInfo.arch);
       }
     }
+    for (auto &file : embeddedFiles) {
+      auto pair = file->GetRawBuffer();
+      bitcodeBuffers.emplace_back(llvm::StringRef(pair.first, pair.second), "");
+    }
   });
 
-  std::vector<std::unique_ptr<llvm::LLVMContext>> contexts;
-  std::vector<mull::LoadBitcodeFromBinaryTask> tasks;
-  for (int i = 0; i < configuration.parallelization.workers; i++) {
-    tasks.emplace_back(mull::LoadBitcodeFromBinaryTask(diagnostics));
-  }
+  mull::BitcodeMetadataReader bitcodeCompilationDatabaseLoader;
+  std::map<std::string, std::string> bitcodeCompilationFlags;
   std::vector<std::unique_ptr<mull::Bitcode>> bitcode;
-  mull::TaskExecutor<mull::LoadBitcodeFromBinaryTask> executor(
-      diagnostics, "Loading bitcode files", embeddedFiles, bitcode, std::move(tasks));
-  executor.execute();
+  if (configuration.memoryBudget == 0) {
+    std::vector<mull::LoadBitcodeFromBinaryTask> tasks;
+    for (int i = 0; i < configuration.parallelization.workers; i++) {
+      tasks.emplace_back(mull::LoadBitcodeFromBinaryTask(diagnostics));
+    }
+    mull::TaskExecutor<mull::LoadBitcodeFromBinaryTask> executor(
+        diagnostics, "Loading bitcode files", bitcodeBuffers, bitcode, std::move(tasks));
+    executor.execute();
 
-  mull::BitcodeMetadataReader bitcodeCompilationDatabaseLoader;
-  std::map<std::string, std::string> bitcodeCompilationFlags =
-      bitcodeCompilationDatabaseLoader.getCompilationDatabase(bitcode);
+    bitcodeCompilationFlags = bitcodeCompilationDatabaseLoader.getCompilationDatabase(bitcode);
+  } else {
+    /// The modules are loaded by the driver batch by batch
+    mull::SingleTaskExecutor readMetadata(diagnostics);
+    readMetadata.execute("Reading bitcode metadata", [&] {
+      bitcodeCompilationFlags =
+          bitcodeCompilationDatabaseLoader.getCompilationDatabase(bitcodeBuffers, diagnostics);
+    });
+  }
 
-  mull::Program program(std::move(bitcode));
+  mull::Program program = configuration.memoryBudget == 0
+                              ? mull::Program(std::move(bitcode))
+                              : mull::Program::fromBitcodeBuffers(std::move(bitcodeBuffers));
 
   mull::Toolchain toolchain(diagnostics, configuration);
 
@@ -194,6 +284,13 @@ int main(int argc, char **argv) {
   std::vector<std::unique_ptr<mull::Reporter>> reporters = reportersOption.reporters(params);
 
   mull::CXXJunkDetector junkDetector(diagnostics, astStorage);
+  mull::CachedJunkDetector cachedJunkDetector(
+      diagnostics, astStorage, junkDetector, tool::JunkCache.getValue());
+  bool junkCacheEnabled = !tool::DisableJunkDetection.getValue() && !tool::JunkCache.empty();
+  if (junkCacheEnabled) {
+    cachedJunkDetector.load();
+  }
+  mull::IRJunkDetector irJunkDetector;
 
   mull::MutationsFinder mutationsFinder(mutatorsOptions.mutators(), configuration);
 
@@ -259,15 +356,42 @@ int main(int argc, char **argv) {
   }
 
   if (!tool::DisableJunkDetection.getValue()) {
-    auto *junkFilter = new mull::JunkMutationFilter(junkDetector);
+    /// The cheap checks go first, so that fewer mutations need the ASTs
+    auto *irJunkFilter = new mull::JunkMutationFilter(irJunkDetector, "IR junk");
+    filters.mutationFilters.push_back(irJunkFilter);
+    filterStorage.emplace_back(irJunkFilter);
+
+    auto *junkFilter = junkCacheEnabled
+                           ? new mull::JunkMutationFilter(cachedJunkDetector)
+                           : new mull::JunkMutationFilter(junkDetector);
     filters.mutationFilters.push_back(junkFilter);
     filterStorage.emplace_back(junkFilter);
   }
 
+  if (tool::PruneEquivalentMutants.getValue()) {
+    auto *equivalentMutationFilter = new mull::EquivalentMutationFilter;
+    filters.mutationFilters.push_back(equivalentMutationFilter);
+    filterStorage.emplace_back(equivalentMutationFilter);
+  }
+
   mull::Driver driver(diagnostics, configuration, program, toolchain, filters, mutationsFinder);
   auto result = driver.run();
+  if (junkCacheEnabled) {
+    cachedJunkDetector.save();
+  }
 
   if (!configuration.mutateOnly) {
+    if (configuration.shardCount > 1) {
+      mull::writePartialResult(diagnostics,
+                               mull::partialResultPath(tool::ReportDirectory.getValue(),
+                                                       tool::ReportName.getValue(),
+                                                       configuration.shardIndex,
+                                                       configuration.shardCount),
+                               *result,
+                               configuration.shardIndex,
+                               configuration.shardCount,
+                               driver.getShardedMutants());
+    }
     for (auto &reporter : reporters) {
       reporter->reportResults(*result);
     }
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CLIOptions.h"
+
+namespace tool {
+using namespace mull;
+using namespace llvm::cl;
+
+OptionCategory MullCategory("mull-merge");
+PartialResults_();
+DumpCLIInterface_();
+ReportersOption_();
+DebugEnabled_();
+StrictModeEnabled_();
+ReportName_();
+ReportDirectory_();
+IDEReporterShowKilled_();
+
+void dumpCLIInterface(mull::Diagnostics &diagnostics) {
+  // Enumerating CLI options explicitly to control the order and what to show
+  Option *reporters = &(Option &)ReportersOption;
+  std::vector<Option *> mullOptions({
+      &ReportName,
+      &ReportDirectory,
+      reporters,
+      &IDEReporterShowKilled,
+      &DebugEnabled,
+      &StrictModeEnabled,
+  });
+  dumpCLIInterface(diagnostics, mullOptions, reporters, nullptr);
+}
+
+} // namespace tool
@@ -0,0 +1,66 @@
+#include "mull-merge-cli.h"
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Metrics/MetricsMeasure.h"
+#include "mull/Result.h"
+#include "mull/Sharding.h"
+#include "mull/Version.h"
+
+#include <memory>
+#include <sstream>
+
+int main(int argc, char **argv) {
+  mull::Diagnostics diagnostics;
+  llvm::cl::SetVersionPrinter(mull::printVersionInformation);
+
+  tool::ReportersCLIOptions reportersOption(diagnostics, tool::ReportersOption);
+
+  llvm::cl::HideUnrelatedOptions(tool::MullCategory);
+  bool validOptions = llvm::cl::ParseCommandLineOptions(argc, argv, "", &llvm::errs());
+  if (!validOptions) {
+    if (tool::DumpCLIInterface) {
+      tool::dumpCLIInterface(diagnostics);
+      return 0;
+    }
+    return 1;
+  }
+
+  if (tool::DebugEnabled) {
+    diagnostics.enableDebugMode();
+    diagnostics.debug("Diagnostics: Debug Mode enabled. Debug-level messages will be printed.");
+  }
+
+  if (tool::StrictModeEnabled) {
+    diagnostics.enableStrictMode();
+    diagnostics.info(
+        "Diagnostics: Strict Mode enabled. Warning messages will be treated as fatal errors.");
+  }
+
+  mull::MetricsMeasure totalExecutionTime;
+  totalExecutionTime.start();
+
+  tool::ReporterParameters params{ .reporterName = tool::ReportName.getValue(),
+                                   .reporterDirectory = tool::ReportDirectory.getValue(),
+                                   .compilationDatabaseAvailable = false,
+                                   .IDEReporterShowKilled = tool::IDEReporterShowKilled };
+  std::vector<std::unique_ptr<mull::Reporter>> reporters = reportersOption.reporters(params);
+
+  std::vector<std::string> paths(tool::PartialResults.begin(), tool::PartialResults.end());
+  std::unique_ptr<mull::Result> result = mull::mergePartialResults(diagnostics, paths);
+
+  std::stringstream message;
+  message << "Merged " << result->getMutants().size() << " mutants from " << paths.size()
+          << " partial results";
+  diagnostics.info(message.str());
+
+  for (auto &reporter : reporters) {
+    reporter->reportResults(*result);
+  }
+  llvm::llvm_shutdown();
+  totalExecutionTime.finish();
+  std::stringstream stringstream;
+  stringstream << "Total execution time: " << totalExecutionTime.duration()
+               << mull::MetricsMeasure::precision();
+  diagnostics.info(stringstream.str());
+
+  return 0;
+}
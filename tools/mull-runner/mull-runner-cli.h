@@ -23,6 +23,10 @@ IDEReporterShowKilled_();
 IncludeNotCovered_();
 RunnerArgs_();
 TestProgram_();
+ForkServerOption_();
+WorkerCommands_();
+ShardIndex_();
+ShardCount_();
 
 void dumpCLIInterface(mull::Diagnostics &diagnostics) {
   // Enumerating CLI options explicitly to control the order and what to show
@@ -32,6 +36,10 @@ void dumpCLIInterface(mull::Diagnostics &diagnostics) {
 
       &Workers,
       &Timeout,
+      &ForkServerOption,
+      &(Option &)WorkerCommands,
+      &ShardIndex,
+      &ShardCount,
 
       &ReportName,
       &ReportDirectory,
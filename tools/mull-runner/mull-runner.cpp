@@ -5,8 +5,11 @@
 #include "mull/Metrics/MetricsMeasure.h"
 #include "mull/MutantRunner.h"
 #include "mull/Result.h"
+#include "mull/Sharding.h"
 #include "mull/Version.h"
 
+#include <algorithm>
+#include <csignal>
 #include <memory>
 #include <unistd.h>
 
@@ -26,6 +29,9 @@ static std::string validateInputFile(const std::string &inputFile, mull::Diagnos
 }
 
 int main(int argc, char **argv) {
+  /// A dead worker or fork server must not kill Mull, broken pipes are reported by write()
+  signal(SIGPIPE, SIG_IGN);
+
   mull::Diagnostics diagnostics;
   llvm::cl::SetVersionPrinter(mull::printVersionInformation);
 
@@ -65,6 +71,14 @@ int main(int argc, char **argv) {
 
   configuration.executable = inputFile;
 
+  if (tool::ShardCount > 1) {
+    if (tool::ShardIndex >= tool::ShardCount) {
+      diagnostics.error("-shard-index must be less than -shard-count");
+    }
+    configuration.shardIndex = tool::ShardIndex;
+    configuration.shardCount = tool::ShardCount;
+  }
+
   if (tool::Workers) {
     mull::ParallelizationConfig parallelizationConfig;
     parallelizationConfig.workers = tool::Workers;
@@ -93,6 +107,17 @@ int main(int argc, char **argv) {
     testProgram = tool::TestProgram.getValue();
   }
 
+  if (tool::ForkServerOption.getValue()) {
+    if (testProgram == executable) {
+      configuration.forkServer = true;
+    } else {
+      diagnostics.warning("-fork-server requires the mutated program to be the test program, "
+                          "the fork server will be disabled");
+    }
+  }
+
+  configuration.workerCommands.assign(tool::WorkerCommands.begin(), tool::WorkerCommands.end());
+
   std::vector<std::string> extraArgs;
   for (size_t argIndex = 0; argIndex < tool::RunnerArgs.getNumOccurrences(); argIndex++) {
     extraArgs.push_back(tool::RunnerArgs[argIndex]);
@@ -100,12 +125,34 @@ int main(int argc, char **argv) {
 
   mull::MutantExtractor mutantExtractor(diagnostics);
   std::vector<std::unique_ptr<mull::Mutant>> mutants = mutantExtractor.extractMutants(executable);
+  mull::MutantSet allMutants = mull::describeMutants(mutants);
+  if (configuration.shardCount > 1) {
+    /// Every machine must see the same list to agree on the shards
+    std::sort(mutants.begin(), mutants.end(), mull::MutantComparator());
+    /// There is no timing information in the executable: only the covered mutants run
+    mutants = mull::selectShard(
+        std::move(mutants),
+        [](const mull::Mutant &mutant) { return mutant.isCovered() ? 1LL : 0LL; },
+        configuration.shardIndex,
+        configuration.shardCount);
+  }
 
   mull::MutantRunner mutantRunner(diagnostics, configuration);
   std::vector<std::unique_ptr<mull::MutationResult>> mutationResults =
       mutantRunner.runMutants(testProgram, extraArgs, mutants);
 
   auto result = std::make_unique<mull::Result>(std::move(mutants), std::move(mutationResults));
+  if (configuration.shardCount > 1) {
+    mull::writePartialResult(diagnostics,
+                             mull::partialResultPath(tool::ReportDirectory.getValue(),
+                                                     tool::ReportName.getValue(),
+                                                     configuration.shardIndex,
+                                                     configuration.shardCount),
+                             *result,
+                             configuration.shardIndex,
+                             configuration.shardCount,
+                             allMutants);
+  }
   for (auto &reporter : reporters) {
     reporter->reportResults(*result);
   }
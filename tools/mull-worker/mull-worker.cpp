@@ -0,0 +1,34 @@
+#include "mull/Diagnostics/Diagnostics.h"
+#include "mull/Toolchain/WorkerProtocol.h"
+#include "mull/Version.h"
+
+#include <llvm/Support/CommandLine.h>
+#include <unistd.h>
+
+using namespace llvm::cl;
+
+static OptionCategory MullCategory("mull-worker");
+
+static opt<bool> DebugEnabled("debug", desc("Enables Debug Mode: more logs are printed"),
+                              Optional, init(false), cat(MullCategory));
+
+/// Reads the requests from stdin and writes the results to stdout, see WorkerProtocol.h
+int main(int argc, char **argv) {
+  /// stdout carries the protocol: everything else, including the logs, goes to stderr
+  int output = dup(STDOUT_FILENO);
+  dup2(STDERR_FILENO, STDOUT_FILENO);
+
+  mull::Diagnostics diagnostics;
+  SetVersionPrinter(mull::printVersionInformation);
+  HideUnrelatedOptions(MullCategory);
+  if (!ParseCommandLineOptions(argc, argv, "", &llvm::errs())) {
+    return 1;
+  }
+  if (DebugEnabled) {
+    diagnostics.enableDebugMode();
+  }
+
+  mull::serveWorkerRequests(diagnostics, STDIN_FILENO, output);
+  close(output);
+  return 0;
+}